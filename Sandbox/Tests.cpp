@@ -1,6 +1,8 @@
 #pragma once
 #include <ManiTests/ManiTests.h>
 #include <ManiZ/ManiZ.h>
+#include <sstream>
+#include <chrono>
 #include <MyTestModule.h>
 
 MANI_SECTION_BEGIN(Reflection, "reflection")
@@ -84,6 +86,23 @@ MANI_SECTION_BEGIN(Reflection, "reflection")
 		}
 	}
 
+	MANI_TEST(ShouldGetMemberNameTable, "Should get a compile time member name table")
+	{
+		struct Transform
+		{
+			float position;
+			float rotation;
+			float scale;
+		};
+
+		constexpr auto& names = ManiZ::RFL::getMemberNameTable<Transform>();
+		static_assert(names.size() == 3);
+
+		MANI_TEST_ASSERT(names[0] == "position", "member name should match");
+		MANI_TEST_ASSERT(names[1] == "rotation", "member name should match");
+		MANI_TEST_ASSERT(names[2] == "scale", "member name should match");
+	}
+
 	MANI_TEST(ShouldGetClassName, "Should get class name")
 	{
 		class MyTestClass {};
@@ -124,6 +143,46 @@ MANI_SECTION_BEGIN(Reflection, "reflection")
 }
 MANI_SECTION_END(Reflection)
 
+MANI_SECTION_BEGIN(Simd, "Simd")
+{
+	MANI_TEST(ShouldSkipWhitespaces, "Should skip whitespaces across vector widths")
+	{
+		bool result = true;
+		for (size_t length = 0; length < 80; length++)
+		{
+			std::string text;
+			for (size_t i = 0; i < length; i++)
+			{
+				text += " \t\r\n"[i % 4];
+			}
+			text += "x   ";
+
+			const char* it = ManiZ::SIMD::skipWhitespaces(text.data(), text.data() + text.size());
+			result &= it == text.data() + length;
+
+			const char* end = ManiZ::SIMD::skipWhitespaces(text.data(), text.data() + length);
+			result &= end == text.data() + length;
+		}
+		MANI_TEST_ASSERT(result, "should stop on the first non whitespace character");
+	}
+
+	MANI_TEST(ShouldFindQuotesAndBackslashes, "Should find quotes and backslashes across vector widths")
+	{
+		bool result = true;
+		for (size_t length = 0; length < 80; length++)
+		{
+			const std::string text = std::string(length, 'a') + (length % 2 == 0 ? "\"" : "\\") + std::string(40, '"');
+			const char* it = ManiZ::SIMD::findQuoteOrBackslash(text.data(), text.data() + text.size());
+			result &= it == text.data() + length;
+
+			const char* end = ManiZ::SIMD::findQuoteOrBackslash(text.data(), text.data() + length);
+			result &= end == text.data() + length;
+		}
+		MANI_TEST_ASSERT(result, "should stop on the first quote or backslash");
+	}
+}
+MANI_SECTION_END(Simd)
+
 MANI_SECTION_BEGIN(Json, "Json")
 {
 	MANI_TEST(ShouldSerializeAndDeserializeAStruct, "Should serialize then deserialize a struct to json")
@@ -211,6 +270,132 @@ MANI_SECTION_BEGIN(Json, "Json")
 		}
 	}
 
+	MANI_TEST(JsonObjectLayout, "Json objects should be compact and keep their members in order")
+	{
+		static_assert(sizeof(void*) != 8 || sizeof(ManiZ::JsonObject) == 16);
+
+		const ManiZ::JsonObject json = ManiZ::from::parse("{\"b\": 1, \"a\": {}, \"c\": null}");
+		MANI_TEST_ASSERT(json.getType() == ManiZ::EJsonType::Object && json.size() == 3, "should have parsed 3 members");
+		MANI_TEST_ASSERT(json.getMembers()[0].first == "b" && json.getMembers()[1].first == "a" && json.getMembers()[2].first == "c", "members should be in insertion order");
+		MANI_TEST_ASSERT(json.getAt(0).get<int>() == 1, "should match value");
+		MANI_TEST_ASSERT(json["a"].isValid() && json["a"].size() == 0, "an empty object should be valid");
+		MANI_TEST_ASSERT(json.has("c") && !json["c"].isValid(), "null values should be kept as invalid values");
+		MANI_TEST_ASSERT(!json["missing"].isValid() && !json["missing"]["nested"].isValid(), "missing keys should return a null value");
+	}
+
+	MANI_TEST(ShouldParseIntoAJsonDocument, "Should parse documents into a reusable arena")
+	{
+		ManiZ::JsonDocument document;
+		ManiZ::JsonObject copy;
+		{
+			const ManiZ::JsonObject& root = document.parse("{\"name\": \"first\", \"values\": [1, 2, 3]}");
+			MANI_TEST_ASSERT(root["name"].get<std::string_view>() == "first", "should match value");
+			MANI_TEST_ASSERT(root["values"].size() == 3, "should match value");
+			copy = root;
+		}
+
+		const ManiZ::JsonObject& root = document.parse("{\"name\": \"second\"}");
+		MANI_TEST_ASSERT(root["name"].get<std::string>() == "second", "the arena should be reusable");
+		MANI_TEST_ASSERT(copy["name"].get<std::string>() == "first" && copy["values"].size() == 3, "copies should outlive the arena's content");
+
+		std::pmr::monotonic_buffer_resource resource;
+		const ManiZ::JsonObject json = ManiZ::from::parse("{\"a\": [\"x\", \"y\"]}", &resource);
+		MANI_TEST_ASSERT(json["a"].getArray()[1].get<std::string>() == "y", "should parse into any memory resource");
+	}
+
+	MANI_TEST(ShouldParseWithAStructuralIndex, "Should parse the same document with the two stage parser")
+	{
+		// long enough to span several 64 bytes blocks, with escapes crossing block boundaries.
+		std::string text = "{\"padding\": \"";
+		text.append(60, 'x');
+		text += "\\\\\\\"{[,:]}\", \"values\": [1, -2, 3.5, true, null, {\"nested\": [\"a\\u00e9\", []]}], \"empty\": {}}";
+
+		const ManiZ::JsonObject expected = ManiZ::from::parse(text);
+		const ManiZ::JsonObject json = ManiZ::from::parseIndexed(text);
+		MANI_TEST_ASSERT(json["padding"].get<std::string>() == expected["padding"].get<std::string>(), "should match value");
+		MANI_TEST_ASSERT(json["padding"].get<std::string>().ends_with("\\\"{[,:]}"), "should unescape value");
+
+		const auto& values = json["values"].getArray();
+		MANI_TEST_ASSERT(values.size() == 6, "should match value");
+		MANI_TEST_ASSERT(values[0].get<int>() == 1 && values[1].get<int>() == -2 && values[2].get<float>() == 3.5f, "should match value");
+		MANI_TEST_ASSERT(values[3].get<bool>() && values[4].getType() == ManiZ::EJsonType::Null, "should match value");
+		MANI_TEST_ASSERT(values[5]["nested"].getArray()[0].get<std::string>() == expected["values"].getArray()[5]["nested"].getArray()[0].get<std::string>(), "should match value");
+		MANI_TEST_ASSERT(json["empty"].getType() == ManiZ::EJsonType::Object, "should match value");
+
+		MANI_TEST_ASSERT(ManiZ::from::parseIndexed("{\"a\": \"unterminated}").getType() == ManiZ::EJsonType::Null, "should fail on unterminated strings");
+		MANI_TEST_ASSERT(ManiZ::from::parseIndexed("{\"a\" 1}").getType() == ManiZ::EJsonType::Null, "should fail on missing colons");
+	}
+
+	MANI_TEST(ShouldSkipValuesOfAnotherType, "Should not read values that don't have the expected type")
+	{
+		struct Test
+		{
+			int id = 0;
+			std::string name = "default";
+			std::vector<int> values;
+		};
+
+		const std::string_view jsonString = R"({"id":2,"name":12345678,"values":{"a":1}})";
+		const ManiZ::JsonObject json = ManiZ::from::parse(jsonString);
+		MANI_TEST_ASSERT(json["name"].get<std::string>().empty() && !json["name"].is<std::string>(), "a number should not be read as a string");
+		MANI_TEST_ASSERT(json["id"].get<bool>() == false && json["values"].get<int>() == 0, "mismatched types should return a default value");
+
+		const Test t = ManiZ::from::json<Test>(json);
+		MANI_TEST_ASSERT(t.id == 2 && t.name == "default" && t.values.empty(), "mismatched members should be skipped");
+
+		const Test direct = ManiZ::from::json<Test>(jsonString);
+		MANI_TEST_ASSERT(direct.id == 2 && direct.name == "default", "the direct reader should stop at the mismatched member");
+	}
+
+	MANI_TEST(ShouldNotReadNumbersOutOfRange, "Should not read numbers that don't fit the expected type")
+	{
+		const ManiZ::JsonObject json = ManiZ::from::parse(R"({"big":1e300,"half":1.5,"whole":2.0,"negative":-1,"wide":3000000000})");
+		MANI_TEST_ASSERT(!json["big"].is<int>() && json["big"].get<int>() == 0 && !json["big"].is<float>() && json["big"].is<double>(), "1e300 should only fit a double");
+		MANI_TEST_ASSERT(!json["half"].is<int>() && json["whole"].is<int>() && json["whole"].get<int>() == 2, "only whole floats should be read as integers");
+		MANI_TEST_ASSERT(!json["negative"].is<uint32_t>() && json["negative"].get<int8_t>() == -1, "negative numbers should not be read as unsigned");
+		MANI_TEST_ASSERT(!json["wide"].is<int>() && json["wide"].get<int64_t>() == 3000000000 && json["wide"].get<uint32_t>() == 3000000000u, "should match value");
+	}
+
+	MANI_TEST(ShouldKeepTheLastDuplicateKey, "Should resolve duplicate keys the same way in every parser")
+	{
+		struct Test
+		{
+			int a = 0;
+		};
+
+		const std::string_view jsonString = R"({"a":1,"a":2})";
+		MANI_TEST_ASSERT(ManiZ::from::json<Test>(jsonString).a == 2, "the direct reader should keep the last value");
+		MANI_TEST_ASSERT(ManiZ::from::json<Test>(ManiZ::from::parse(jsonString)).a == 2, "the document should keep the last value");
+		MANI_TEST_ASSERT(ManiZ::from::parseIndexed(jsonString)["a"].get<int>() == 2 && ManiZ::from::parse(jsonString)["a"].get<int>() == 2, "lookups should find the last value");
+
+		ManiZ::JsonStreamParser parser;
+		ManiZ::JsonObject streamed;
+		MANI_TEST_ASSERT(parser.feed(jsonString) && parser.next(streamed) && streamed["a"].get<int>() == 2, "the stream parser should keep the last value");
+	}
+
+	MANI_TEST(ShouldParseWideObjects, "Should parse objects with many keys in linear time")
+	{
+		// inserting a member must not look for the previous keys, this used to take seconds.
+		std::string jsonString = "{";
+		for (int i = 0; i < 40000; i++)
+		{
+			jsonString += std::format("{}\"key{}\":{}", i == 0 ? "" : ",", i, i);
+		}
+		jsonString += ",\"key0\":-1}";
+
+		const auto start = std::chrono::steady_clock::now();
+		const ManiZ::JsonObject json = ManiZ::from::parse(jsonString);
+		const ManiZ::JsonObject indexed = ManiZ::from::parseIndexed(jsonString);
+		ManiZ::JsonStreamParser parser;
+		ManiZ::JsonObject streamed;
+		MANI_TEST_ASSERT(parser.feed(jsonString) && parser.next(streamed), "the stream parser should accept the object");
+		const auto duration = std::chrono::steady_clock::now() - start;
+
+		MANI_TEST_ASSERT(json.size() == 40001 && json["key39999"].get<int>() == 39999 && json["key0"].get<int>() == -1, "should match value");
+		MANI_TEST_ASSERT(indexed["key20000"].get<int>() == 20000 && streamed["key0"].get<int>() == -1, "should match value");
+		MANI_TEST_ASSERT(duration < std::chrono::seconds(2), "parsing a wide object should not be quadratic");
+	}
+
 	MANI_TEST(ShouldSerializeAndParse, "Should serialize then parse the json string")
 	{
 		struct Vector
@@ -474,5 +659,768 @@ MANI_SECTION_BEGIN(Json, "Json")
 		static_assert(count == 0);
 		const Test result = ManiZ::from::json<Test>("");
 	}
+
+	MANI_TEST(ShouldAppendToACallerOwnedBuffer, "Should append the json to a caller owned buffer")
+	{
+		struct Test
+		{
+			int a = 1;
+			std::vector<int> b = { 2, 3 };
+		};
+
+		const Test t;
+		const std::string expected = ManiZ::to::json(t);
+
+		std::string buffer = "prefix";
+		ManiZ::to::json(buffer, t, ManiZ::EJsonFormat::Pretty);
+		MANI_TEST_ASSERT(buffer == "prefix" + expected, "the json should be appended after the existing content");
+
+		buffer.clear();
+		ManiZ::to::json(buffer, t, ManiZ::EJsonFormat::Pretty);
+		MANI_TEST_ASSERT(buffer == expected, "a reused buffer should produce the same json");
+
+		std::string text = "salut";
+		MANI_TEST_ASSERT(ManiZ::to::json(text, ManiZ::EJsonFormat::Compact) == "\"salut\"" && text == "salut", "a string with a format should be serialized, not appended to");
+	}
+
+	MANI_TEST(ShouldSerializeCompactJson, "Should serialize to compact json without trailing commas")
+	{
+		struct Vector
+		{
+			int x;
+			int y;
+		};
+
+		struct Test
+		{
+			Vector position;
+			std::vector<int> values;
+			std::string name;
+		};
+
+		const Test t = { { 1, 2 }, { 3, 4 }, "salut" };
+
+		const std::string compact = ManiZ::to::json(t, ManiZ::EJsonFormat::Compact);
+		MANI_TEST_ASSERT(compact == "{\"position\":{\"x\":1,\"y\":2},\"values\":[3,4],\"name\":\"salut\"}", "compact json should not have whitespaces");
+
+		const std::string pretty = ManiZ::to::json(t);
+		MANI_TEST_ASSERT(pretty.find(",\n\t}") == std::string::npos && pretty.find(",\n}") == std::string::npos, "pretty json should not have trailing commas");
+
+		const Test t2 = ManiZ::from::json<Test>(compact);
+		MANI_TEST_ASSERT(t2.position.x == 1 && t2.position.y == 2, "should have deserialized properly");
+		MANI_TEST_ASSERT(t2.values == t.values, "should have deserialized properly");
+		MANI_TEST_ASSERT(t2.name == t.name, "should have deserialized properly");
+	}
+
+	MANI_TEST(ShouldEscapeStrings, "Should escape and unescape special characters in strings")
+	{
+		struct Test
+		{
+			std::string value;
+		};
+
+		const Test t = { "say \"hello\"\n\tC:\\path" };
+		const std::string json = ManiZ::to::json(t, ManiZ::EJsonFormat::Compact);
+		MANI_TEST_ASSERT(json == "{\"value\":\"say \\\"hello\\\"\\n\\tC:\\\\path\"}", "special characters should be escaped");
+
+		const Test t2 = ManiZ::from::json<Test>(json);
+		MANI_TEST_ASSERT(t2.value == t.value, "should have deserialized properly");
+
+		const Test t3 = ManiZ::from::json<Test>("{\"value\":\"caf\\u00e9\"}");
+		MANI_TEST_ASSERT(t3.value == "caf\xC3\xA9", "unicode escapes should be decoded to utf-8");
+	}
+
+	MANI_TEST(ShouldParseNumbers, "Should classify and convert numbers without allocating")
+	{
+		const ManiZ::JsonObject json = ManiZ::from::parse("[1e5, -2.5E-3, -9223372036854775808, 18446744073709551615, 36893488147419103232, 0]");
+		const auto& values = json.getArray();
+		MANI_TEST_ASSERT(values[0].getType() == ManiZ::EJsonType::Float && values[0].get<double>() == 1e5, "exponents should be floating points");
+		MANI_TEST_ASSERT(values[1].get<double>() == -2.5e-3, "should match value");
+		MANI_TEST_ASSERT(values[2].getType() == ManiZ::EJsonType::Integer && values[2].get<int64_t>() == std::numeric_limits<int64_t>::min(), "should use 64 bits integers");
+		MANI_TEST_ASSERT(values[3].getType() == ManiZ::EJsonType::Unsigned && values[3].get<uint64_t>() == std::numeric_limits<uint64_t>::max(), "should use 64 bits integers");
+		MANI_TEST_ASSERT(values[4].getType() == ManiZ::EJsonType::Float, "out of range integers should be floating points");
+		MANI_TEST_ASSERT(values[5].getType() == ManiZ::EJsonType::Unsigned, "should match type");
+
+		MANI_TEST_ASSERT(ManiZ::from::parse("[12abc]").getType() == ManiZ::EJsonType::Null, "should fail on invalid numbers");
+		MANI_TEST_ASSERT(ManiZ::from::parse("[-inf]").getType() == ManiZ::EJsonType::Null, "should fail on invalid numbers");
+
+		struct Test
+		{
+			int i;
+			float f;
+			uint8_t u;
+		};
+
+		const Test t = ManiZ::from::json<Test>("{\"i\": 1e2, \"f\": 0.1, \"u\": 200}");
+		MANI_TEST_ASSERT(t.i == 100 && t.f == 0.1f && t.u == 200, "should convert to the destination type");
+	}
+
+	MANI_TEST(ShouldFailOnNumbersOutOfRange, "Should not truncate numbers that don't fit the destination")
+	{
+		struct Small
+		{
+			uint8_t x = 7;
+			int y = 5;
+		};
+
+		struct Wide
+		{
+			unsigned u = 7;
+			int i = 7;
+		};
+
+		// the read stops at the first error, the next members keep their default value.
+		const Small small = ManiZ::from::json<Small>(R"({"x":300,"y":1})");
+		MANI_TEST_ASSERT(small.x == 7 && small.y == 5, "300 should not be read into an uint8_t");
+		MANI_TEST_ASSERT(ManiZ::from::json<Wide>(R"({"u":-1,"i":1})").i == 7, "-1 should not be read into an unsigned");
+		MANI_TEST_ASSERT(ManiZ::from::json<Wide>(R"({"i":3000000000,"u":1})").u == 7, "3000000000 should not be read into an int");
+		MANI_TEST_ASSERT(ManiZ::from::json<Wide>(R"({"i":1e10,"u":1})").u == 7, "1e10 should not be read into an int");
+
+		const Wide wide = ManiZ::from::json<Wide>(R"({"u":1.0,"i":-1e2})");
+		MANI_TEST_ASSERT(wide.u == 1 && wide.i == -100, "whole floats should be read into integers");
+
+		// the object builder skips them like values of another type.
+		const Small built = ManiZ::from::json<Small>(ManiZ::from::parse(R"({"x":300,"y":1})"));
+		MANI_TEST_ASSERT(built.x == 7 && built.y == 1, "300 should be skipped");
+		MANI_TEST_ASSERT(ManiZ::from::json<Wide>(ManiZ::from::parse(R"({"u":-1,"i":3000000000})")).u == 7, "should be skipped");
+		MANI_TEST_ASSERT(ManiZ::from::json<Wide>(ManiZ::from::parse(R"({"u":-1,"i":3000000000})")).i == 7, "should be skipped");
+	}
+
+	MANI_TEST(ShouldRoundTripFloatingPointValues, "Should write the shortest floating point representation that round-trips")
+	{
+		struct Test
+		{
+			double small;
+			double large;
+			double fraction;
+			float single;
+			double integral;
+		};
+
+		const Test t = { 1e-9, 1.7976931348623157e308, 0.1, 3.14159f, 5.0 };
+		const std::string json = ManiZ::to::json(t, ManiZ::EJsonFormat::Compact);
+		MANI_TEST_ASSERT(json == "{\"small\":1e-09,\"large\":1.7976931348623157e+308,\"fraction\":0.1,\"single\":3.14159,\"integral\":5}", "numbers should use their shortest representation");
+
+		const Test t2 = ManiZ::from::json<Test>(json);
+		MANI_TEST_ASSERT(t2.small == t.small, "values should round-trip exactly");
+		MANI_TEST_ASSERT(t2.large == t.large, "values should round-trip exactly");
+		MANI_TEST_ASSERT(t2.fraction == t.fraction, "values should round-trip exactly");
+		MANI_TEST_ASSERT(t2.single == t.single, "values should round-trip exactly");
+		MANI_TEST_ASSERT(t2.integral == t.integral, "values should round-trip exactly");
+	}
+
+	MANI_TEST(ShouldParseFromAByteRange, "Should parse json from a string view or a raw byte range")
+	{
+		struct Test
+		{
+			int a = 0;
+			std::string b;
+		};
+
+		// the json is followed by unrelated bytes, only the given range should be read.
+		const char buffer[] = "{\"a\": 4, \"b\": \"salut\"}{\"a\": 5}";
+		const size_t size = std::string_view(buffer).find('}') + 1;
+
+		const Test t = ManiZ::from::json<Test>(buffer, size);
+		MANI_TEST_ASSERT(t.a == 4 && t.b == "salut", "t should be equal to the json values");
+
+		const std::string_view view(buffer + size);
+		const ManiZ::JsonObject json = ManiZ::from::parse(view);
+		MANI_TEST_ASSERT(json.isValid() && json["a"].get<int>() == 5, "json should be equal to the view's values");
+	}
+
+	MANI_TEST(ShouldSkipUnknownKeys, "Should skip keys that are not members of the struct")
+	{
+		struct Test
+		{
+			int a = 0;
+			std::vector<int> b;
+		};
+
+		const std::string jsonString = "{\"unknown\": {\"x\": [1, \"]}\", {}], \"y\": null}, \"a\": 4, \"other\": \"}\", \"b\": [1, 2]}";
+		const Test t = ManiZ::from::json<Test>(jsonString);
+		MANI_TEST_ASSERT(t.a == 4, "t should be equal to the json values");
+		MANI_TEST_ASSERT(t.b == std::vector<int>({ 1, 2 }), "t should be equal to the json values");
+	}
+
+	MANI_TEST(ShouldDeserializeFromAJsonObject, "Should build a struct from an already parsed json object")
+	{
+		struct Vector
+		{
+			int x = 0;
+			int y = 0;
+		};
+
+		struct Test
+		{
+			std::vector<Vector> data;
+		};
+
+		const ManiZ::JsonObject json = ManiZ::from::parse("{\"data\": [{\"x\": 1, \"y\": 2}, {\"x\": 3, \"y\": 4}]}");
+		const Test t = ManiZ::from::json<Test>(json);
+		MANI_TEST_ASSERT(t.data.size() == 2, "should have deserialized 2 vectors");
+		MANI_TEST_ASSERT(t.data[0].x == 1 && t.data[0].y == 2 && t.data[1].x == 3 && t.data[1].y == 4, "vectors should be equal");
+	}
+
+	MANI_TEST(ShouldWriteAndReadJsonLines, "Should write one compact record per line and read them back one at a time")
+	{
+		struct Record
+		{
+			int id = 0;
+			std::string message;
+			std::vector<int> values;
+		};
+
+		const std::vector<Record> records = { { 1, "first", { 1, 2 } }, { 2, "second\nline", {} }, { 3, "third", { 3 } } };
+		const std::string lines = ManiZ::to::jsonLines(records);
+		MANI_TEST_ASSERT(lines == "{\"id\":1,\"message\":\"first\",\"values\":[1,2]}\n{\"id\":2,\"message\":\"second\\nline\",\"values\":[]}\n{\"id\":3,\"message\":\"third\",\"values\":[3]}\n", "should match value");
+
+		std::stringstream outStream;
+		ManiZ::to::jsonLines(outStream, records, 16);
+		MANI_TEST_ASSERT(outStream.str() == lines, "should write the same lines to a stream");
+
+		std::vector<Record> readRecords;
+		for (const Record& record : ManiZ::from::jsonLines<Record>(lines))
+		{
+			readRecords.push_back(record);
+		}
+		MANI_TEST_ASSERT(readRecords.size() == 3 && readRecords[1].message == "second\nline" && readRecords[2].values.size() == 1, "should match value");
+
+		// blank and invalid lines are skipped, missing members don't keep the previous values.
+		std::stringstream stream;
+		stream << "{\"id\": 4, \"values\": [4]}\r\n\n{\"id\": oops}\n{\"id\": 5}";
+		ManiZ::JsonLinesReader<Record> reader = ManiZ::from::jsonLines<Record>(stream);
+		MANI_TEST_ASSERT(reader.next() && reader.get().id == 4 && reader.get().values.size() == 1, "should match value");
+		MANI_TEST_ASSERT(reader.next() && reader.get().id == 5 && reader.get().values.empty(), "should match value");
+		MANI_TEST_ASSERT(!reader.next(), "should stop at the end of the stream");
+	}
+
+	MANI_TEST(ShouldParseChunkedInput, "Should parse documents fed in chunks split anywhere")
+	{
+		struct Point
+		{
+			int x = 0;
+			float y = 0.0f;
+			std::string name;
+		};
+
+		const std::string text = "{\"x\": -12345, \"y\": 2.5e1, \"name\": \"a \\\"quoted\\\" \\u00e9 name\", \"tags\": [true, null, [], {}]} [1, 22, 333] \"done\"";
+		for (size_t chunkSize = 1; chunkSize <= text.size(); chunkSize++)
+		{
+			ManiZ::JsonStreamParser parser;
+			for (size_t i = 0; i < text.size(); i += chunkSize)
+			{
+				MANI_TEST_ASSERT(parser.feed(std::string_view(text).substr(i, chunkSize)), "every chunk should be accepted");
+			}
+			MANI_TEST_ASSERT(parser.finish(), "the input should be complete");
+
+			Point point;
+			ManiZ::JsonObject array;
+			ManiZ::JsonObject last;
+			MANI_TEST_ASSERT(parser.next(point) && parser.next(array) && parser.next(last) && !parser.next(last), "should emit every document");
+			MANI_TEST_ASSERT(point.x == -12345 && point.y == 25.0f && point.name == "a \"quoted\" \u00e9 name", "should match value");
+			MANI_TEST_ASSERT(array.size() == 3 && array.getArray()[2].get<int>() == 333, "should match value");
+			MANI_TEST_ASSERT(last.get<std::string>() == "done", "should match value");
+		}
+
+		ManiZ::JsonStreamParser parser;
+		MANI_TEST_ASSERT(parser.feed("{\"a\": [1, 2") && !parser.finish(), "unfinished documents should fail");
+		parser.reset();
+		MANI_TEST_ASSERT(!parser.feed("{\"a\" 1}"), "invalid documents should fail");
+
+		// values of the wrong type come from the network as well, they're skipped.
+		parser.reset();
+		Point mismatched;
+		MANI_TEST_ASSERT(parser.feed("{\"x\": 2, \"name\": 12345678, \"y\": \"1\"}") && parser.next(mismatched), "the document should be valid json");
+		MANI_TEST_ASSERT(mismatched.x == 2 && mismatched.name.empty() && mismatched.y == 0.0f, "mismatched members should be skipped");
+
+		for (const std::string_view trailing : { "[1,]", "{\"a\": 1,}", "[,]", "[1,,]" })
+		{
+			parser.reset();
+			const bool isValid = parser.feed(trailing) && parser.finish();
+			MANI_TEST_ASSERT(isValid == ManiZ::from::parse(trailing).isValid(), "trailing commas should be handled like parse does");
+		}
+	}
+
+	MANI_TEST(ShouldSerializeIntoABufferedSink, "Should stream the json through a fixed size buffer")
+	{
+		struct Entity
+		{
+			std::string name;
+			std::vector<int> values;
+		};
+
+		std::vector<Entity> world;
+		for (int i = 0; i < 100; i++)
+		{
+			world.push_back({ std::format("entity {}", i), { i, i * 2, i * 3 } });
+		}
+
+		std::string output;
+		size_t largestFlush = 0;
+		ManiZ::BufferedSink sink([&](std::string_view data)
+		{
+			largestFlush = std::max(largestFlush, data.size());
+			output.append(data);
+			return true;
+		}, 256);
+
+		MANI_TEST_ASSERT(ManiZ::to::json(sink, world, ManiZ::EJsonFormat::Pretty), "the sink should accept every write");
+		MANI_TEST_ASSERT(output == ManiZ::to::json(world), "should write the same json as a string");
+		MANI_TEST_ASSERT(largestFlush <= 256 && sink.getWrittenSize() == output.size(), "should never buffer more than its size");
+
+		std::stringstream stream;
+		MANI_TEST_ASSERT(ManiZ::to::json(stream, world, ManiZ::EJsonFormat::Compact) && stream.str() == ManiZ::to::json(world, ManiZ::EJsonFormat::Compact), "should write to streams");
+
+		ManiZ::BufferedSink failingSink([](std::string_view) { return false; }, 16);
+		MANI_TEST_ASSERT(!ManiZ::to::json(failingSink, world, ManiZ::EJsonFormat::Pretty) && failingSink.hasError(), "should report write failures");
+	}
+
+	MANI_TEST(ShouldWriteAndReadJsonFiles, "Should write a json file and read it back through a mapping")
+	{
+		struct Scene
+		{
+			std::string name;
+			std::vector<float> positions;
+		};
+
+		const Scene scene = { "level", { 1.0f, 2.5f, -3.0f } };
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "ManiZ_ShouldWriteAndReadJsonFiles.json";
+		MANI_TEST_ASSERT(ManiZ::to::jsonFile(path, scene), "should write the file");
+
+		const Scene scene2 = ManiZ::from::jsonFile<Scene>(path);
+		MANI_TEST_ASSERT(scene2.name == scene.name && scene2.positions == scene.positions, "should match value");
+
+		const ManiZ::JsonObject json = ManiZ::from::parseFile(path);
+		MANI_TEST_ASSERT(json["name"].get<std::string>() == "level" && json["positions"].size() == 3, "should match value");
+
+		const ManiZ::MappedFile file(path);
+		MANI_TEST_ASSERT(file.isOpen() && file.getView() == ManiZ::to::json(scene), "the mapping should hold the file's content");
+
+		std::filesystem::remove(path);
+		MANI_TEST_ASSERT(!ManiZ::MappedFile(path).isOpen(), "missing files should fail to open");
+	}
+
+	MANI_TEST(ShouldReadLargeArraysInParallel, "Should read the elements of large arrays with several threads")
+	{
+		struct Element
+		{
+			int id = 0;
+			std::string name;
+			std::vector<int> values;
+		};
+
+		struct World
+		{
+			std::string name;
+			std::vector<Element> elements;
+		};
+
+		World world = { "world" };
+		for (int i = 0; i < 5000; i++)
+		{
+			// separators and brackets inside strings must not be taken as element boundaries.
+			world.elements.push_back({ i, std::format("[{}], {{\"", i), { i, -i } });
+		}
+
+		const std::string jsonString = ManiZ::to::json(world);
+		const World world2 = ManiZ::from::jsonParallel<World>(jsonString, 4);
+		MANI_TEST_ASSERT(world2.name == world.name && world2.elements.size() == world.elements.size(), "should match value");
+
+		bool result = true;
+		for (size_t i = 0; i < world.elements.size(); i++)
+		{
+			result &= world2.elements[i].id == world.elements[i].id && world2.elements[i].name == world.elements[i].name && world2.elements[i].values == world.elements[i].values;
+		}
+		MANI_TEST_ASSERT(result, "every element should match");
+
+		const std::vector<Element> elements = ManiZ::from::jsonParallel<std::vector<Element>>(ManiZ::to::json(world.elements, ManiZ::EJsonFormat::Compact), 3);
+		MANI_TEST_ASSERT(elements.size() == 5000 && elements[4999].name == world.elements[4999].name, "should read top level arrays");
+
+		// the edge cases of the serial reader: trailing comma, whitespaces around every separator and empty arrays.
+		std::string spaced = "[";
+		for (int i = 0; i < 600; i++)
+		{
+			spaced += std::format("{}\n {}\t,{}", i % 7 == 0 ? " " : "", i, i % 3 == 0 ? "\r\n " : "");
+		}
+		spaced += " ]";
+
+		for (const std::string& input : { spaced, std::string("[1, 2,]"), std::string("[ ]"), spaced.substr(0, spaced.size() - 2) + "]" })
+		{
+			const std::vector<int> serial = ManiZ::from::json<std::vector<int>>(input);
+			const std::vector<int> parallel = ManiZ::from::jsonParallel<std::vector<int>>(input, 3);
+			MANI_TEST_ASSERT(serial == parallel, "the parallel reader should read the same elements as the serial one");
+		}
+		MANI_TEST_ASSERT(ManiZ::from::jsonParallel<std::vector<int>>(spaced, 3).size() == 600, "a trailing comma should not add an element");
+	}
+
+	MANI_TEST(ShouldSerializeLargeRangesInParallel, "Should write the same json with several threads")
+	{
+		struct Element
+		{
+			int id;
+			std::string name;
+			std::vector<double> values;
+		};
+
+		struct Snapshot
+		{
+			std::string name;
+			std::vector<Element> elements;
+		};
+
+		Snapshot snapshot = { "snapshot" };
+		for (int i = 0; i < 3000; i++)
+		{
+			snapshot.elements.push_back({ i, std::format("element {}", i), { i * 0.5, -i * 0.25 } });
+		}
+
+		MANI_TEST_ASSERT(ManiZ::to::jsonParallel(snapshot, ManiZ::EJsonFormat::Pretty, 4) == ManiZ::to::json(snapshot), "should be byte identical to the serial output");
+		MANI_TEST_ASSERT(ManiZ::to::jsonParallel(snapshot.elements, ManiZ::EJsonFormat::Compact, 3) == ManiZ::to::json(snapshot.elements, ManiZ::EJsonFormat::Compact), "should be byte identical to the serial output");
+
+		std::string output;
+		ManiZ::BufferedSink sink([&](std::string_view data) { output.append(data); return true; }, 1024);
+		MANI_TEST_ASSERT(ManiZ::to::jsonParallel(sink, snapshot, ManiZ::EJsonFormat::Compact, 4) && output == ManiZ::to::json(snapshot, ManiZ::EJsonFormat::Compact), "should write the chunks to sinks in order");
+	}
+
+	MANI_TEST(ShouldReuseRecordsAcrossBatches, "Should read and write batches of records in place")
+	{
+		struct Record
+		{
+			int id = 0;
+			int level = 3;
+			std::string name;
+			std::vector<std::string> tags;
+		};
+
+		std::vector<Record> records;
+		for (int i = 0; i < 4; i++)
+		{
+			records.push_back({ i, i, std::format("a record name longer than the small string buffer {}", i), { "first tag that is long enough to allocate", "second" } });
+		}
+
+		std::vector<std::string> documents;
+		ManiZ::to::jsonBatch(documents, records, ManiZ::EJsonFormat::Compact);
+		MANI_TEST_ASSERT(documents.size() == records.size() && documents[1] == ManiZ::to::json(records[1], ManiZ::EJsonFormat::Compact), "should write one document per record");
+
+		ManiZ::JsonReader<Record> reader;
+		std::vector<Record> readRecords;
+		MANI_TEST_ASSERT(ManiZ::from::jsonBatch(reader, documents, readRecords) && readRecords.size() == records.size(), "should read one record per document");
+		MANI_TEST_ASSERT(readRecords[2].name == records[2].name && readRecords[2].tags == records[2].tags && readRecords[2].level == 2, "should read the records");
+
+		// the second batch overwrites the same records, their buffers are kept.
+		const char* name = readRecords[0].name.data();
+		const char* tag = readRecords[0].tags[0].data();
+		const std::vector<std::string> nextDocuments = { R"({"id":7,"name":"short","tags":["tag"]})", R"({"id":8})", R"({"id":9,"name":null,"tags":[1]})" };
+		MANI_TEST_ASSERT(!ManiZ::from::jsonBatch(reader, nextDocuments, readRecords) && readRecords.size() == 3, "should report the invalid document");
+		MANI_TEST_ASSERT(readRecords[0].id == 7 && readRecords[0].name == "short" && readRecords[0].tags == std::vector<std::string>{ "tag" } && readRecords[0].level == 3, "should reset the members missing from the document");
+		MANI_TEST_ASSERT(readRecords[0].name.data() == name && readRecords[0].tags[0].data() == tag, "should reuse the buffers of the records");
+		MANI_TEST_ASSERT(readRecords[1].id == 8 && readRecords[1].name.empty() && readRecords[1].tags.empty() && readRecords[1].level == 3, "should read the records as new ones");
+		MANI_TEST_ASSERT(readRecords[2].id == 0 && readRecords[2].name.empty(), "should leave a default record for invalid documents");
+
+		ManiZ::JsonWriter writer(ManiZ::EJsonFormat::Compact);
+		MANI_TEST_ASSERT(writer.write(readRecords[0]) == R"({"id":7,"level":3,"name":"short","tags":["tag"]})", "should write into the writer's buffer");
+	}
+
+	MANI_TEST(ShouldMatchKeysOfLargeStructs, "Should match every key of a struct with many members in any order")
+	{
+		struct Test
+		{
+			int a = 0, b = 0, c = 0, d = 0, e = 0, f = 0, g = 0, h = 0, i = 0, j = 0, k = 0, l = 0, m = 0;
+			int n = 0, o = 0, p = 0, q = 0, r = 0, s = 0, t = 0, u = 0, v = 0, w = 0, x = 0, y = 0, z = 0;
+		};
+		static_assert(ManiZ::RFL::memberCount<Test>() == 26);
+
+		// keys are written in reverse order and interleaved with unknown keys.
+		std::string jsonString = "{";
+		for (char name = 'z'; name >= 'a'; name--)
+		{
+			jsonString += std::format("\"{}\": {}, \"{}{}\": -1, ", name, name - 'a' + 1, name, name);
+		}
+		jsonString += "\"zz\": 0}";
+
+		const Test test = ManiZ::from::json<Test>(jsonString);
+
+		bool result = true;
+		int expected = 1;
+		ManiZ::RFL::visitMembers(test, [&](const auto& ...members)
+		{
+			((result &= members == expected++), ...);
+		});
+		MANI_TEST_ASSERT(result, "every member should be equal to the json values");
+	}
 }
 MANI_SECTION_END(Json)
+
+MANI_SECTION_BEGIN(Binary, "Binary")
+{
+	MANI_TEST(ShouldSerializeAndReadBinary, "Should write then read the binary representation")
+	{
+		enum class EShape : uint8_t
+		{
+			Circle,
+			Square,
+		};
+
+		struct Point
+		{
+			float x;
+			float y;
+		};
+
+		struct Drawing
+		{
+			std::string name;
+			EShape shape;
+			bool isVisible;
+			int64_t id;
+			std::vector<Point> points;
+			std::array<uint16_t, 3> color;
+			std::vector<std::string> tags;
+		};
+
+		const Drawing d = { "sketch", EShape::Square, true, -42, { { 1.5f, 2.0f }, { -3.0f, 4.25f } }, { 255, 128, 0 }, { "a", "", "long tag" } };
+		const std::vector<std::byte> bytes = ManiZ::to::binary(d);
+
+		// 8 + 6 name, 1 shape, 1 bool, 8 id, 8 + 2 * 8 points, 8 + 3 * 2 color, 8 + 8 + 1 + 8 + 0 + 8 + 8 tags
+		MANI_TEST_ASSERT(bytes.size() == 14 + 1 + 1 + 8 + 24 + 14 + 41, "should use fixed width scalars and length prefixes");
+		MANI_TEST_ASSERT(bytes[0] == std::byte{ 6 } && bytes[1] == std::byte{ 0 }, "sizes should be little endian");
+
+		const Drawing d2 = ManiZ::from::binary<Drawing>(bytes);
+		MANI_TEST_ASSERT(d2.name == d.name && d2.shape == d.shape && d2.isVisible && d2.id == d.id, "should match value");
+		MANI_TEST_ASSERT(d2.points.size() == 2 && d2.points[1].x == -3.0f && d2.points[1].y == 4.25f, "should match value");
+		MANI_TEST_ASSERT(d2.color == d.color && d2.tags == d.tags, "should match value");
+	}
+
+	MANI_TEST(ShouldCopyTrivialBuffersAtOnce, "Should copy buffers of trivially copyable values in one block")
+	{
+		struct Vertex
+		{
+			float x;
+			float y;
+			float z;
+		};
+
+		struct Padded
+		{
+			char c;
+			int32_t i;
+		};
+
+		static_assert(ManiZ::_impl::isBulkCopyable<Vertex>());
+		static_assert(!ManiZ::_impl::isBulkCopyable<Padded>());
+
+		struct Mesh
+		{
+			std::vector<Vertex> vertices;
+			std::array<uint32_t, 3> indices;
+			std::vector<Padded> padded;
+		};
+
+		Mesh mesh;
+		for (uint32_t i = 0; i < 1000; i++)
+		{
+			mesh.vertices.push_back({ i * 1.0f, i * 2.0f, i * 3.0f });
+		}
+		mesh.indices = { 0, 1, 2 };
+		mesh.padded = { { 'a', 1 }, { 'b', 2 } };
+
+		const std::vector<std::byte> bytes = ManiZ::to::binary(mesh);
+		MANI_TEST_ASSERT(bytes.size() == 8 + 1000 * 12 + 8 + 3 * 4 + 8 + 2 * 5, "padding should never be written");
+
+		const Mesh mesh2 = ManiZ::from::binary<Mesh>(bytes);
+		MANI_TEST_ASSERT(mesh2.vertices.size() == 1000 && mesh2.vertices[999].z == 2997.0f, "should match value");
+		MANI_TEST_ASSERT(mesh2.indices == mesh.indices, "should match value");
+		MANI_TEST_ASSERT(mesh2.padded.size() == 2 && mesh2.padded[1].c == 'b' && mesh2.padded[1].i == 2, "should match value");
+	}
+
+	MANI_TEST(ShouldViewBinaryInPlace, "Should read members of a binary buffer without decoding the whole object")
+	{
+		struct Header
+		{
+			uint32_t version;
+			bool isCompressed;
+		};
+
+		struct Pack
+		{
+			Header header;
+			std::vector<std::string> names;
+			std::string description;
+			std::vector<uint8_t> data;
+			double scale;
+		};
+
+		const Pack pack = { { 3, true }, { "first", "second" }, "a pack", { 1, 2, 3, 4 }, 0.5 };
+		const std::vector<std::byte> bytes = ManiZ::to::binary(pack);
+
+		const ManiZ::view<Pack> view(bytes);
+		MANI_TEST_ASSERT(view.get<0>().get<0>() == 3 && view.get<0>().get<1>(), "should read nested members");
+		MANI_TEST_ASSERT(view.get<1>().size() == 2 && view.get<1>()[1] == "second", "strings should be views into the buffer");
+		MANI_TEST_ASSERT(view.get<2>() == "a pack", "should skip the previous members");
+		MANI_TEST_ASSERT(view.get<3>().getSpan()->size() == 4 && (*view.get<3>().getSpan())[3] == 4 && view.get<3>()[2] == 3, "should match value");
+		MANI_TEST_ASSERT(view.get<4>() == 0.5, "should match value");
+
+		const std::string_view name = view.get<1>()[0];
+		MANI_TEST_ASSERT(name.data() >= reinterpret_cast<const char*>(bytes.data()) && name.data() < reinterpret_cast<const char*>(bytes.data() + bytes.size()), "nothing should be copied");
+
+		struct Mesh
+		{
+			uint8_t lod;
+			std::vector<float> positions;
+			std::vector<uint32_t> indices;
+		};
+
+		// the positions start 9 bytes in the buffer, the indices 9 + 8 + 12.
+		const Mesh mesh = { 2, { 0.5f, 1.5f, 2.5f }, { 7, 8 } };
+		const std::vector<std::byte> meshBytes = ManiZ::to::binary(mesh);
+		const ManiZ::view<Mesh> meshView(meshBytes);
+		MANI_TEST_ASSERT(meshView.get<1>().getSpan() == std::nullopt && meshView.get<1>()[2] == 2.5f, "misaligned elements should not be handed out as a span");
+		MANI_TEST_ASSERT(meshView.get<2>().getSpan() == std::nullopt && meshView.get<2>().size() == 2 && meshView.get<2>()[1] == 8, "misaligned elements should not be handed out as a span");
+
+		struct Aligned
+		{
+			uint64_t id;
+			std::vector<uint32_t> indices;
+		};
+
+		const std::vector<std::byte> alignedBytes = ManiZ::to::binary(Aligned{ 1, { 7, 8 } });
+		const std::optional<std::span<const uint32_t>> indices = ManiZ::view<Aligned>(alignedBytes).get<1>().getSpan();
+		MANI_TEST_ASSERT(indices && indices->size() == 2 && (*indices)[1] == 8, "aligned elements should be handed out as a span");
+
+		const std::vector<std::byte> emptyBytes = ManiZ::to::binary(Aligned{ 1, {} });
+		const std::optional<std::span<const uint32_t>> empty = ManiZ::view<Aligned>(emptyBytes).get<1>().getSpan();
+		MANI_TEST_ASSERT(empty && empty->empty(), "an empty container should be an empty span, not nullopt");
+	}
+
+	MANI_TEST(ShouldReadTaggedBinaryAcrossVersions, "Should read tagged binary written by a different version of a struct")
+	{
+		struct Item
+		{
+			int32_t id;
+			std::string name;
+		};
+
+		struct OldVersion
+		{
+			std::string name;
+			int32_t count = 0;
+			std::vector<Item> items;
+		};
+
+		struct NewVersion
+		{
+			int32_t count = 0;
+			double weight = 1.0;
+			std::vector<Item> items;
+			std::string name;
+		};
+
+		static_assert(ManiZ::_impl::getSchemaFingerprint<OldVersion>() != ManiZ::_impl::getSchemaFingerprint<NewVersion>());
+
+		const OldVersion oldVersion = { "old", 3, { { 1, "a" }, { 2, "b" } } };
+		const std::vector<std::byte> oldBytes = ManiZ::to::binary(oldVersion, ManiZ::EBinaryFormat::Tagged);
+
+		const OldVersion sameVersion = ManiZ::from::binary<OldVersion>(oldBytes, ManiZ::EBinaryFormat::Tagged);
+		MANI_TEST_ASSERT(sameVersion.name == "old" && sameVersion.count == 3 && sameVersion.items.size() == 2 && sameVersion.items[1].name == "b", "should match value");
+
+		const NewVersion newVersion = ManiZ::from::binary<NewVersion>(oldBytes, ManiZ::EBinaryFormat::Tagged);
+		MANI_TEST_ASSERT(newVersion.name == "old" && newVersion.count == 3 && newVersion.weight == 1.0, "members should be matched by name");
+		MANI_TEST_ASSERT(newVersion.items.size() == 2 && newVersion.items[0].id == 1 && newVersion.items[1].name == "b", "should match value");
+
+		const std::vector<std::byte> newBytes = ManiZ::to::binary(NewVersion{ 7, 2.5, {}, "new" }, ManiZ::EBinaryFormat::Tagged);
+		const OldVersion fromNewVersion = ManiZ::from::binary<OldVersion>(newBytes, ManiZ::EBinaryFormat::Tagged);
+		MANI_TEST_ASSERT(fromNewVersion.name == "new" && fromNewVersion.count == 7 && fromNewVersion.items.empty(), "unknown members should be skipped");
+	}
+
+	MANI_TEST(ShouldSkipTaggedFieldsWhoseTypeChanged, "Should keep reading the other members when a member's type changed")
+	{
+		struct Before
+		{
+			int32_t count = 0;
+			std::string name;
+			float weight = 0.0f;
+		};
+
+		struct After
+		{
+			int64_t count = -1;
+			std::string name;
+			double weight = 1.0;
+		};
+
+		const std::vector<std::byte> beforeBytes = ManiZ::to::binary(Before{ 3, "before", 2.5f }, ManiZ::EBinaryFormat::Tagged);
+		const After after = ManiZ::from::binary<After>(beforeBytes, ManiZ::EBinaryFormat::Tagged);
+		MANI_TEST_ASSERT(after.count == -1 && after.weight == 1.0, "fields that don't decode should keep the member's value");
+		MANI_TEST_ASSERT(after.name == "before", "the other fields should still be read");
+
+		const std::vector<std::byte> afterBytes = ManiZ::to::binary(After{ 7, "after", 0.5 }, ManiZ::EBinaryFormat::Tagged);
+		const Before before = ManiZ::from::binary<Before>(afterBytes, ManiZ::EBinaryFormat::Tagged);
+		MANI_TEST_ASSERT(before.count == 0 && before.weight == 0.0f && before.name == "after", "fields that aren't read to their end should be skipped");
+	}
+
+	MANI_TEST(ShouldSerializeCompactBinary, "Should write small integers in as few bytes as possible")
+	{
+		enum class EEvent : int32_t
+		{
+			Open,
+			Close = 300,
+		};
+
+		struct Event
+		{
+			uint64_t timestamp;
+			int32_t offset;
+			EEvent type;
+			bool isRemote;
+			float duration;
+			std::string source;
+			std::vector<uint64_t> ids;
+			std::vector<int64_t> values;
+			std::vector<bool> flags;
+		};
+
+		const Event e =
+		{
+			1700000000000, -2, EEvent::Close, true, 0.25f, "log",
+			{ 1000000, 1000001, 1000005, 1000300 },
+			{ 0, -1, 63, -64, 64, std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min(), 1ll << 56, -(1ll << 55), 127, 128 },
+			{ true, false, true, true, false, false, false, true, true },
+		};
+
+		const std::vector<std::byte> bytes = ManiZ::to::binary(e, ManiZ::EBinaryFormat::Compact);
+		MANI_TEST_ASSERT(bytes.size() < ManiZ::to::binary(e).size() / 2, "should be smaller than the fixed layout");
+
+		const Event e2 = ManiZ::from::binary<Event>(bytes, ManiZ::EBinaryFormat::Compact);
+		MANI_TEST_ASSERT(e2.timestamp == e.timestamp && e2.offset == e.offset && e2.type == e.type && e2.isRemote, "should match value");
+		MANI_TEST_ASSERT(e2.duration == e.duration && e2.source == e.source, "should match value");
+		MANI_TEST_ASSERT(e2.ids == e.ids && e2.values == e.values && e2.flags == e.flags, "should match value");
+
+		// 1 byte count, 1 byte sorted flag, then 3 bytes for the first id and a byte per delta.
+		const std::vector<std::byte> idBytes = ManiZ::to::binary(e.ids, ManiZ::EBinaryFormat::Compact);
+		MANI_TEST_ASSERT(idBytes.size() == 1 + 1 + 3 + 1 + 1 + 2, "sorted integers should store their deltas");
+		MANI_TEST_ASSERT(ManiZ::to::binary(e.flags, ManiZ::EBinaryFormat::Compact).size() == 1 + 2, "bools should be packed");
+
+		// the first value of sorted signed integers is zigzagged, a negative one takes a single byte.
+		const std::vector<int64_t> offsets = { -5, -3, 10 };
+		const std::vector<std::byte> offsetBytes = ManiZ::to::binary(offsets, ManiZ::EBinaryFormat::Compact);
+		MANI_TEST_ASSERT(offsetBytes.size() == 1 + 1 + 1 + 1 + 1, "a negative first value should stay small");
+		MANI_TEST_ASSERT(ManiZ::from::binary<std::vector<int64_t>>(offsetBytes, ManiZ::EBinaryFormat::Compact) == offsets, "should match value");
+	}
+
+	MANI_TEST(ShouldFailOnTruncatedBinary, "Should not read past the end of truncated data")
+	{
+		struct Test
+		{
+			std::vector<int32_t> values;
+			std::string name;
+		};
+
+		std::vector<std::byte> bytes = ManiZ::to::binary(Test{ { 1, 2, 3 }, "name" });
+		bytes.resize(bytes.size() - 2);
+
+		const Test t = ManiZ::from::binary<Test>(bytes);
+		MANI_TEST_ASSERT(t.values.size() == 3 && t.name.empty(), "should stop at the truncated member");
+	}
+}
+MANI_SECTION_END(Binary)
@@ -0,0 +1,1313 @@
+#pragma once
+
+#include <ManiZ/Reflection.h>
+#include <ManiZ/Traits.h>
+#include <vector>
+#include <string>
+#include <span>
+#include <optional>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <format>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <assert.h>
+#include <limits>
+
+// binary layout:
+// - scalars are fixed width and little endian, bools are one byte and enums use their underlying type.
+// - strings and containers are a uint64_t length followed by their characters or elements.
+// - aggregates are their members, in declaration order, without names nor padding.
+// tagged layout, for readers and writers that don't share the exact same types:
+// - a uint64_t schema fingerprint, then the value.
+// - aggregates are fields: a uint32_t id hashed from the member name, a uint32_t byte length and the member.
+// - aggregates in containers are prefixed with their uint32_t byte length, everything else is written as above.
+// compact layout, for integer heavy data:
+// - integers wider than a byte are LEB128 varints, zigzagged when signed. Lengths are varints too.
+// - containers of integers start with a byte telling whether they're sorted, sorted ones store their first value then the varint deltas between elements.
+// - containers of bools are packed 8 per byte, everything else is written as in the fixed layout.
+namespace ManiZ
+{
+	enum class EBinaryFormat : uint8_t
+	{
+		// members one after the other, smallest and fastest.
+		Fixed,
+		// members can be added, removed or reordered between the writer's and the reader's types.
+		Tagged,
+		// small integers take a single byte, slower to read and write than fixed.
+		Compact,
+	};
+
+	namespace _impl
+	{
+		template<typename T>
+		inline consteval bool isBulkCopyable();
+		template<typename T>
+		inline consteval bool areMembersBulkCopyable();
+		template<typename T>
+		inline consteval auto getMemberTypes();
+		template<typename T>
+		inline consteval bool hasTaggedEncoding();
+		template<typename T>
+		inline consteval uint64_t getSchemaFingerprint();
+		template<typename T, size_t ...I>
+		inline consteval uint64_t getMembersFingerprint(std::index_sequence<I...>);
+		inline constexpr uint64_t combineHash(uint64_t hash, uint64_t value);
+		template<typename T>
+		inline constexpr bool isVarint = std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) > 1;
+		template<typename T>
+		inline constexpr std::make_unsigned_t<T> encodeZigzag(T value);
+		template<typename T>
+		inline constexpr std::make_signed_t<T> decodeZigzag(T value);
+		inline constexpr uint32_t getFieldId(std::string_view name);
+		template<typename T>
+		inline consteval std::array<uint32_t, RFL::memberCount<T>()> makeFieldIds();
+		template<typename T>
+		inline consteval bool areFieldIdsUnique();
+
+		// std::tuple of the member types of an aggregate.
+		template<typename T>
+		using MemberTypes = typename decltype(getMemberTypes<T>())::type;
+
+		// true when the binary representation of T is exactly its memory representation, so it can be copied in one memcpy.
+		template<typename T>
+		inline consteval bool isBulkCopyable()
+		{
+			if constexpr (std::endian::native != std::endian::little)
+			{
+				return false;
+			}
+			else if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, long double>)
+			{
+				// bools are normalized to 0 or 1, long doubles have padding bytes.
+				return false;
+			}
+			else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+			{
+				return true;
+			}
+			else if constexpr (std::is_trivially_copyable_v<T> && std::is_aggregate_v<T> && !std::ranges::range<T>)
+			{
+				if constexpr (RFL::memberCount<T>() > 0)
+				{
+					return areMembersBulkCopyable<T>();
+				}
+			}
+			return false;
+		}
+
+		template<typename T>
+		inline consteval bool areMembersBulkCopyable()
+		{
+			return []<typename ...M>(std::type_identity<std::tuple<M...>>)
+			{
+				// padding bytes would be written as garbage, the members have to fill the whole struct.
+				return (isBulkCopyable<M>() && ...) && (sizeof(M) + ... + 0) == sizeof(T);
+			}(std::type_identity<MemberTypes<T>>());
+		}
+
+		template<typename T>
+		inline consteval auto getMemberTypes()
+		{
+			return decltype(RFL::visitMembers(std::declval<const T&>(), [](const auto& ...members)
+			{
+				return std::type_identity<std::tuple<std::remove_cvref_t<decltype(members)>...>>();
+			}))();
+		}
+
+		// aggregates are the only values written differently in the tagged format, as well as the containers holding them.
+		template<typename T>
+		inline consteval bool hasTaggedEncoding()
+		{
+			if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_same_v<T, std::string>)
+			{
+				return false;
+			}
+			else if constexpr (std::ranges::range<T>)
+			{
+				return hasTaggedEncoding<std::ranges::range_value_t<T>>();
+			}
+			else
+			{
+				return true;
+			}
+		}
+
+		// changes whenever a member is added, removed, renamed, reordered or changes type, at any depth.
+		template<typename T>
+		inline consteval uint64_t getSchemaFingerprint()
+		{
+			if constexpr (std::is_same_v<T, bool>)
+			{
+				return combineHash(1, 1);
+			}
+			else if constexpr (std::is_enum_v<T>)
+			{
+				return combineHash(2, getSchemaFingerprint<std::underlying_type_t<T>>());
+			}
+			else if constexpr (std::is_floating_point_v<T>)
+			{
+				return combineHash(3, sizeof(T));
+			}
+			else if constexpr (std::is_integral_v<T>)
+			{
+				return combineHash(std::is_signed_v<T> ? 4 : 5, sizeof(T));
+			}
+			else if constexpr (std::is_same_v<T, std::string>)
+			{
+				return combineHash(6, 0);
+			}
+			else if constexpr (std::ranges::range<T>)
+			{
+				return combineHash(7, getSchemaFingerprint<std::ranges::range_value_t<T>>());
+			}
+			else
+			{
+				return getMembersFingerprint<T>(std::make_index_sequence<RFL::memberCount<T>()>());
+			}
+		}
+
+		template<typename T, size_t ...I>
+		inline consteval uint64_t getMembersFingerprint(std::index_sequence<I...>)
+		{
+			constexpr auto& names = RFL::getMemberNameTable<T>();
+			uint64_t hash = combineHash(8, sizeof...(I));
+			((hash = combineHash(combineHash(hash, getFieldId(names[I])), getSchemaFingerprint<std::tuple_element_t<I, MemberTypes<T>>>())), ...);
+			return hash;
+		}
+
+		inline constexpr uint64_t combineHash(uint64_t hash, uint64_t value)
+		{
+			// fnv-1a over the bytes of value
+			for (uint32_t i = 0; i < 8; i++)
+			{
+				hash ^= (value >> (i * 8)) & 0xFF;
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		inline constexpr uint32_t getFieldId(std::string_view name)
+		{
+			// fnv-1a, folded to 32 bits
+			uint64_t hash = 14695981039346656037ull;
+			for (const char c : name)
+			{
+				hash ^= static_cast<uint8_t>(c);
+				hash *= 1099511628211ull;
+			}
+			return static_cast<uint32_t>(hash ^ (hash >> 32));
+		}
+
+		template<typename T>
+		inline consteval std::array<uint32_t, RFL::memberCount<T>()> makeFieldIds()
+		{
+			constexpr auto& names = RFL::getMemberNameTable<T>();
+			std::array<uint32_t, RFL::memberCount<T>()> ids = {};
+			for (size_t i = 0; i < ids.size(); i++)
+			{
+				ids[i] = getFieldId(names[i]);
+			}
+			return ids;
+		}
+
+		template<typename T>
+		inline consteval bool areFieldIdsUnique()
+		{
+			auto ids = makeFieldIds<T>();
+			std::ranges::sort(ids);
+			return std::ranges::adjacent_find(ids) == ids.end();
+		}
+
+		template<typename T>
+		inline constexpr std::array<uint32_t, RFL::memberCount<T>()> fieldIds = makeFieldIds<T>();
+
+		// small negative values become small unsigned values: 0, -1, 1, -2... are 0, 1, 2, 3...
+		template<typename T>
+		inline constexpr std::make_unsigned_t<T> encodeZigzag(T value)
+		{
+			using unsignedType = std::make_unsigned_t<T>;
+			return static_cast<unsignedType>((static_cast<unsignedType>(value) << 1) ^ static_cast<unsignedType>(value >> (sizeof(T) * 8 - 1)));
+		}
+
+		template<typename T>
+		inline constexpr std::make_signed_t<T> decodeZigzag(T value)
+		{
+			return static_cast<std::make_signed_t<T>>((value >> 1) ^ (T(0) - (value & 1)));
+		}
+	}
+
+	namespace to
+	{
+		namespace _impl
+		{
+			inline void writeBinary(std::vector<std::byte>& out, const auto& data);
+			template<typename T>
+			inline void writeScalar(std::vector<std::byte>& out, T value);
+			inline void writeBytes(std::vector<std::byte>& out, const void* data, size_t size);
+			inline void writeTagged(std::vector<std::byte>& out, const auto& data);
+			inline void writeTaggedElement(std::vector<std::byte>& out, const auto& data);
+			inline void writeCompact(std::vector<std::byte>& out, const auto& data);
+			template<typename T>
+			inline void writeCompactIntegers(std::vector<std::byte>& out, const auto& data);
+			inline void writeVarint(std::vector<std::byte>& out, uint64_t value);
+			template<typename T, size_t ...I>
+			inline void writeTaggedMembers(std::vector<std::byte>& out, std::index_sequence<I...>, const auto& ...members);
+			inline size_t beginFrame(std::vector<std::byte>& out);
+			inline void endFrame(std::vector<std::byte>& out, size_t offset);
+
+			inline void writeBinary(std::vector<std::byte>& out, const auto& data)
+			{
+				using type = std::remove_cvref_t<decltype(data)>;
+				static_assert(!std::is_pointer_v<type>);
+
+				if constexpr (std::is_same_v<type, bool>)
+				{
+					writeScalar(out, static_cast<uint8_t>(data ? 1 : 0));
+				}
+				else if constexpr (std::is_enum_v<type>)
+				{
+					writeScalar(out, static_cast<std::underlying_type_t<type>>(data));
+				}
+				else if constexpr (std::is_arithmetic_v<type>)
+				{
+					writeScalar(out, data);
+				}
+				else if constexpr (std::is_same_v<type, std::string> || std::is_same_v<type, std::string_view>)
+				{
+					writeScalar(out, static_cast<uint64_t>(data.size()));
+					writeBytes(out, data.data(), data.size());
+				}
+				else if constexpr (std::ranges::range<type>)
+				{
+					writeScalar(out, static_cast<uint64_t>(std::ranges::distance(data)));
+					if constexpr (std::ranges::contiguous_range<type> && ManiZ::_impl::isBulkCopyable<std::ranges::range_value_t<type>>())
+					{
+						// the whole buffer is written at once.
+						writeBytes(out, std::ranges::data(data), std::ranges::size(data) * sizeof(std::ranges::range_value_t<type>));
+					}
+					else
+					{
+						for (const auto& v : data)
+						{
+							writeBinary(out, v);
+						}
+					}
+				}
+				else if constexpr (ManiZ::_impl::isBulkCopyable<type>())
+				{
+					writeBytes(out, &data, sizeof(type));
+				}
+				else
+				{
+					// we're in an aggregate type
+					RFL::visitMembers(data, [&](const auto& ...members)
+					{
+						(writeBinary(out, members), ...);
+					});
+				}
+			}
+
+			template<typename T>
+			inline void writeScalar(std::vector<std::byte>& out, T value)
+			{
+				auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+				if constexpr (std::endian::native == std::endian::big)
+				{
+					std::ranges::reverse(bytes);
+				}
+				writeBytes(out, bytes.data(), bytes.size());
+			}
+
+			inline void writeBytes(std::vector<std::byte>& out, const void* data, size_t size)
+			{
+				if (size == 0)
+				{
+					return;
+				}
+
+				const size_t offset = out.size();
+				out.resize(offset + size);
+				std::memcpy(out.data() + offset, data, size);
+			}
+
+			inline void writeTagged(std::vector<std::byte>& out, const auto& data)
+			{
+				using type = std::remove_cvref_t<decltype(data)>;
+
+				if constexpr (!ManiZ::_impl::hasTaggedEncoding<type>())
+				{
+					writeBinary(out, data);
+				}
+				else if constexpr (std::ranges::range<type>)
+				{
+					writeScalar(out, static_cast<uint64_t>(std::ranges::distance(data)));
+					for (const auto& v : data)
+					{
+						writeTaggedElement(out, v);
+					}
+				}
+				else
+				{
+					// we're in an aggregate type
+					RFL::visitMembers(data, [&](const auto& ...members)
+					{
+						writeTaggedMembers<type>(out, std::index_sequence_for<decltype(members)...>(), members...);
+					});
+				}
+			}
+
+			inline void writeTaggedElement(std::vector<std::byte>& out, const auto& data)
+			{
+				using type = std::remove_cvref_t<decltype(data)>;
+
+				if constexpr (ManiZ::_impl::hasTaggedEncoding<type>() && !std::ranges::range<type>)
+				{
+					// aggregates have no end marker, their length tells where the next element starts.
+					const size_t offset = beginFrame(out);
+					writeTagged(out, data);
+					endFrame(out, offset);
+				}
+				else
+				{
+					writeTagged(out, data);
+				}
+			}
+
+			template<typename T, size_t ...I>
+			inline void writeTaggedMembers(std::vector<std::byte>& out, std::index_sequence<I...>, const auto& ...members)
+			{
+				static_assert(ManiZ::_impl::areFieldIdsUnique<T>(), "two member names hash to the same field id, rename one of them");
+				constexpr auto& ids = ManiZ::_impl::fieldIds<T>;
+				const auto writeField = [&](uint32_t id, const auto& member)
+				{
+					writeScalar(out, id);
+					const size_t offset = beginFrame(out);
+					writeTagged(out, member);
+					endFrame(out, offset);
+				};
+				(writeField(ids[I], members), ...);
+			}
+
+			inline size_t beginFrame(std::vector<std::byte>& out)
+			{
+				// the length is written once the content is known.
+				const size_t offset = out.size();
+				writeScalar(out, uint32_t(0));
+				return offset;
+			}
+
+			inline void endFrame(std::vector<std::byte>& out, size_t offset)
+			{
+				const size_t size = out.size() - offset - sizeof(uint32_t);
+				assert(size <= std::numeric_limits<uint32_t>::max());
+
+				auto bytes = std::bit_cast<std::array<std::byte, sizeof(uint32_t)>>(static_cast<uint32_t>(size));
+				if constexpr (std::endian::native == std::endian::big)
+				{
+					std::ranges::reverse(bytes);
+				}
+				std::memcpy(out.data() + offset, bytes.data(), bytes.size());
+			}
+
+			inline void writeCompact(std::vector<std::byte>& out, const auto& data)
+			{
+				using type = std::remove_cvref_t<decltype(data)>;
+				static_assert(!std::is_pointer_v<type>);
+
+				if constexpr (std::is_enum_v<type>)
+				{
+					writeCompact(out, static_cast<std::underlying_type_t<type>>(data));
+				}
+				else if constexpr (ManiZ::_impl::isVarint<type>)
+				{
+					if constexpr (std::is_signed_v<type>)
+					{
+						writeVarint(out, ManiZ::_impl::encodeZigzag(data));
+					}
+					else
+					{
+						writeVarint(out, data);
+					}
+				}
+				else if constexpr (std::is_arithmetic_v<type>)
+				{
+					// bools, bytes and floating points
+					writeBinary(out, data);
+				}
+				else if constexpr (std::is_same_v<type, std::string> || std::is_same_v<type, std::string_view>)
+				{
+					writeVarint(out, data.size());
+					writeBytes(out, data.data(), data.size());
+				}
+				else if constexpr (std::ranges::range<type>)
+				{
+					using valueType = std::ranges::range_value_t<type>;
+					const size_t count = static_cast<size_t>(std::ranges::distance(data));
+					writeVarint(out, count);
+
+					if constexpr (std::is_same_v<valueType, bool>)
+					{
+						uint8_t bits = 0;
+						size_t index = 0;
+						for (const bool v : data)
+						{
+							bits |= static_cast<uint8_t>(v ? 1 : 0) << (index % 8);
+							if (++index % 8 == 0)
+							{
+								writeScalar(out, bits);
+								bits = 0;
+							}
+						}
+
+						if (index % 8 != 0)
+						{
+							writeScalar(out, bits);
+						}
+					}
+					else if constexpr (ManiZ::_impl::isVarint<valueType>)
+					{
+						writeCompactIntegers<valueType>(out, data);
+					}
+					else if constexpr (std::ranges::contiguous_range<type> && std::is_arithmetic_v<valueType> && ManiZ::_impl::isBulkCopyable<valueType>())
+					{
+						// bytes and floating points are copied as they are.
+						writeBytes(out, std::ranges::data(data), count * sizeof(valueType));
+					}
+					else
+					{
+						for (const auto& v : data)
+						{
+							writeCompact(out, v);
+						}
+					}
+				}
+				else
+				{
+					// we're in an aggregate type
+					RFL::visitMembers(data, [&](const auto& ...members)
+					{
+						(writeCompact(out, members), ...);
+					});
+				}
+			}
+
+			template<typename T>
+			inline void writeCompactIntegers(std::vector<std::byte>& out, const auto& data)
+			{
+				using unsignedType = std::make_unsigned_t<T>;
+
+				// ids and timestamps are usually sorted, their deltas are much smaller than the values themselves.
+				const bool isSorted = std::ranges::is_sorted(data);
+				writeScalar(out, static_cast<uint8_t>(isSorted ? 1 : 0));
+
+				// the first value has nothing to be relative to, it's zigzagged like unsorted values so that a negative one stays small.
+				unsignedType previous = 0;
+				bool isFirst = true;
+				for (const T v : data)
+				{
+					if (isSorted && !isFirst)
+					{
+						writeVarint(out, static_cast<unsignedType>(static_cast<unsignedType>(v) - previous));
+					}
+					else if constexpr (std::is_signed_v<T>)
+					{
+						writeVarint(out, ManiZ::_impl::encodeZigzag(v));
+					}
+					else
+					{
+						writeVarint(out, v);
+					}
+					previous = static_cast<unsignedType>(v);
+					isFirst = false;
+				}
+			}
+
+			inline void writeVarint(std::vector<std::byte>& out, uint64_t value)
+			{
+				// 7 bits per byte, the high bit is set on every byte but the last.
+				std::array<std::byte, 10> bytes;
+				size_t size = 0;
+				while (value >= 0x80)
+				{
+					bytes[size++] = static_cast<std::byte>(value | 0x80);
+					value >>= 7;
+				}
+				bytes[size++] = static_cast<std::byte>(value);
+				writeBytes(out, bytes.data(), size);
+			}
+		}
+
+		// appends the binary representation of data to out, the buffer can be reused across calls to avoid reallocations.
+		inline void binary(std::vector<std::byte>& out, const auto& data, EBinaryFormat format = EBinaryFormat::Fixed)
+		{
+			if (format == EBinaryFormat::Tagged)
+			{
+				_impl::writeScalar(out, ManiZ::_impl::getSchemaFingerprint<std::remove_cvref_t<decltype(data)>>());
+				_impl::writeTagged(out, data);
+			}
+			else if (format == EBinaryFormat::Compact)
+			{
+				_impl::writeCompact(out, data);
+			}
+			else
+			{
+				_impl::writeBinary(out, data);
+			}
+		}
+
+		inline std::vector<std::byte> binary(const auto& data, EBinaryFormat format = EBinaryFormat::Fixed)
+		{
+			std::vector<std::byte> out;
+			binary(out, data, format);
+			return out;
+		}
+	}
+
+	template<typename T>
+	class view;
+
+	namespace from
+	{
+		namespace _impl
+		{
+			struct BinaryReader
+			{
+				const std::byte* begin = nullptr;
+				const std::byte* it = nullptr;
+				const std::byte* end = nullptr;
+
+				size_t getRemaining() const { return end - it; }
+			};
+
+			inline bool readBinary(BinaryReader& reader, auto& data);
+			template<typename T>
+			inline bool readScalar(BinaryReader& reader, T& outValue);
+			inline bool readSize(BinaryReader& reader, size_t& outSize);
+			inline bool readBytes(BinaryReader& reader, void* outData, size_t size);
+			inline void reportError(const BinaryReader& reader);
+			template<typename T>
+			inline bool skipBinary(BinaryReader& reader);
+			inline bool readTagged(BinaryReader& reader, auto& data, bool isSchemaMatching);
+			inline bool readTaggedElement(BinaryReader& reader, auto& data, bool isSchemaMatching);
+			template<typename T, size_t ...I>
+			inline bool readTaggedMembers(BinaryReader& reader, bool isSchemaMatching, std::index_sequence<I...>, auto& ...members);
+			inline void readTaggedField(BinaryReader& frame, auto& member);
+			inline bool readFrame(BinaryReader& reader, BinaryReader& outFrame);
+			inline bool readCompact(BinaryReader& reader, auto& data);
+			template<typename T>
+			inline bool readCompactInteger(BinaryReader& reader, T& outValue);
+			inline bool readBulk(BinaryReader& reader, auto& data, uint64_t count);
+			inline bool readElements(auto& data, uint64_t count, auto&& readElement);
+			inline bool readVarint(BinaryReader& reader, uint64_t& outValue);
+			template<typename T>
+			inline auto readView(BinaryReader& reader, bool isValid);
+
+			inline bool readBinary(BinaryReader& reader, auto& data)
+			{
+				using type = std::remove_cvref_t<decltype(data)>;
+				static_assert(!std::is_pointer_v<type>);
+
+				if constexpr (std::is_same_v<type, bool>)
+				{
+					uint8_t value = 0;
+					if (!readScalar(reader, value))
+					{
+						return false;
+					}
+					data = value != 0;
+					return true;
+				}
+				else if constexpr (std::is_enum_v<type>)
+				{
+					std::underlying_type_t<type> value = {};
+					if (!readScalar(reader, value))
+					{
+						return false;
+					}
+					data = static_cast<type>(value);
+					return true;
+				}
+				else if constexpr (std::is_arithmetic_v<type>)
+				{
+					return readScalar(reader, data);
+				}
+				else if constexpr (std::is_same_v<type, std::string>)
+				{
+					size_t size = 0;
+					if (!readSize(reader, size))
+					{
+						return false;
+					}
+					data.assign(reinterpret_cast<const char*>(reader.it), size);
+					reader.it += size;
+					return true;
+				}
+				else if constexpr (std::ranges::range<type>)
+				{
+					uint64_t count = 0;
+					if (!readScalar(reader, count))
+					{
+						return false;
+					}
+
+					using valueType = std::ranges::range_value_t<type>;
+					if constexpr (std::ranges::contiguous_range<type> && ManiZ::_impl::isBulkCopyable<valueType>())
+					{
+						return readBulk(reader, data, count);
+					}
+					else
+					{
+						if constexpr (requires { data.reserve(count); })
+						{
+							// a corrupted count can't make us reserve more elements than there are bytes left.
+							data.reserve(static_cast<size_t>(std::min<uint64_t>(count, reader.getRemaining())));
+						}
+
+						return readElements(data, count, [&](auto& element)
+						{
+							return readBinary(reader, element);
+						});
+					}
+				}
+				else if constexpr (ManiZ::_impl::isBulkCopyable<type>())
+				{
+					return readBytes(reader, &data, sizeof(type));
+				}
+				else
+				{
+					// we're in an aggregate type
+					return RFL::visitMembers(data, [&](auto& ...members)
+					{
+						return (readBinary(reader, members) && ...);
+					});
+				}
+			}
+
+			template<typename T>
+			inline bool readScalar(BinaryReader& reader, T& outValue)
+			{
+				std::array<std::byte, sizeof(T)> bytes;
+				if (!readBytes(reader, bytes.data(), bytes.size()))
+				{
+					return false;
+				}
+
+				if constexpr (std::endian::native == std::endian::big)
+				{
+					std::ranges::reverse(bytes);
+				}
+				outValue = std::bit_cast<T>(bytes);
+				return true;
+			}
+
+			inline bool readSize(BinaryReader& reader, size_t& outSize)
+			{
+				uint64_t size = 0;
+				if (!readScalar(reader, size) || size > reader.getRemaining())
+				{
+					return false;
+				}
+
+				outSize = static_cast<size_t>(size);
+				return true;
+			}
+
+			inline bool readBytes(BinaryReader& reader, void* outData, size_t size)
+			{
+				if (size > reader.getRemaining())
+				{
+					return false;
+				}
+
+				if (size > 0)
+				{
+					std::memcpy(outData, reader.it, size);
+					reader.it += size;
+				}
+				return true;
+			}
+
+			inline void reportError(const BinaryReader& reader)
+			{
+				std::cout << std::format("[ManiZ::binary]: failed to read, invalid data at byte {}", reader.it - reader.begin) << std::endl;
+			}
+
+			inline bool readTagged(BinaryReader& reader, auto& data, bool isSchemaMatching)
+			{
+				using type = std::remove_cvref_t<decltype(data)>;
+
+				if constexpr (!ManiZ::_impl::hasTaggedEncoding<type>())
+				{
+					return readBinary(reader, data);
+				}
+				else if constexpr (std::ranges::range<type>)
+				{
+					uint64_t count = 0;
+					if (!readScalar(reader, count))
+					{
+						return false;
+					}
+
+					return readElements(data, count, [&](auto& element)
+					{
+						return readTaggedElement(reader, element, isSchemaMatching);
+					});
+				}
+				else
+				{
+					// we're in an aggregate type, its fields run until the end of the reader.
+					return RFL::visitMembers(data, [&](auto& ...members)
+					{
+						return readTaggedMembers<type>(reader, isSchemaMatching, std::index_sequence_for<decltype(members)...>(), members...);
+					});
+				}
+			}
+
+			inline bool readTaggedElement(BinaryReader& reader, auto& data, bool isSchemaMatching)
+			{
+				using type = std::remove_cvref_t<decltype(data)>;
+
+				if constexpr (ManiZ::_impl::hasTaggedEncoding<type>() && !std::ranges::range<type>)
+				{
+					BinaryReader frame;
+					return readFrame(reader, frame) && readTagged(frame, data, isSchemaMatching);
+				}
+				else
+				{
+					return readTagged(reader, data, isSchemaMatching);
+				}
+			}
+
+			template<typename T, size_t ...I>
+			inline bool readTaggedMembers(BinaryReader& reader, bool isSchemaMatching, std::index_sequence<I...>, auto& ...members)
+			{
+				if (isSchemaMatching)
+				{
+					// both sides have the same types, the fields are in declaration order and the ids don't need to be checked.
+					const auto readField = [&](auto& member)
+					{
+						uint32_t id = 0;
+						BinaryReader frame;
+						return readScalar(reader, id) && readFrame(reader, frame) && readTagged(frame, member, true);
+					};
+					return (readField(members) && ...);
+				}
+
+				constexpr auto& ids = ManiZ::_impl::fieldIds<T>;
+				while (reader.getRemaining() > 0)
+				{
+					uint32_t id = 0;
+					BinaryReader frame;
+					if (!readScalar(reader, id) || !readFrame(reader, frame))
+					{
+						return false;
+					}
+
+					// unknown fields are skipped, members missing from the data keep their value.
+					((id == ids[I] && (readTaggedField(frame, members), true)) || ...);
+				}
+				return true;
+			}
+
+			inline void readTaggedField(BinaryReader& frame, auto& member)
+			{
+				// a field whose type changed doesn't decode, or doesn't fill its frame exactly.
+				// the frame is already skipped, the member keeps its value like for a missing field.
+				std::remove_cvref_t<decltype(member)> value{};
+				if (readTagged(frame, value, false) && frame.it == frame.end)
+				{
+					std::swap(member, value);
+				}
+			}
+
+			inline bool readFrame(BinaryReader& reader, BinaryReader& outFrame)
+			{
+				uint32_t size = 0;
+				if (!readScalar(reader, size) || size > reader.getRemaining())
+				{
+					return false;
+				}
+
+				outFrame.begin = reader.begin;
+				outFrame.it = reader.it;
+				outFrame.end = reader.it + size;
+				reader.it += size;
+				return true;
+			}
+
+			inline bool readCompact(BinaryReader& reader, auto& data)
+			{
+				using type = std::remove_cvref_t<decltype(data)>;
+				static_assert(!std::is_pointer_v<type>);
+
+				if constexpr (std::is_enum_v<type>)
+				{
+					std::underlying_type_t<type> value = {};
+					if (!readCompact(reader, value))
+					{
+						return false;
+					}
+					data = static_cast<type>(value);
+					return true;
+				}
+				else if constexpr (ManiZ::_impl::isVarint<type>)
+				{
+					return readCompactInteger(reader, data);
+				}
+				else if constexpr (std::is_arithmetic_v<type>)
+				{
+					return readBinary(reader, data);
+				}
+				else if constexpr (std::is_same_v<type, std::string>)
+				{
+					uint64_t size = 0;
+					if (!readVarint(reader, size) || size > reader.getRemaining())
+					{
+						return false;
+					}
+					data.assign(reinterpret_cast<const char*>(reader.it), static_cast<size_t>(size));
+					reader.it += size;
+					return true;
+				}
+				else if constexpr (std::ranges::range<type>)
+				{
+					using valueType = std::ranges::range_value_t<type>;
+					uint64_t count = 0;
+					// every element takes at least a bit, a corrupted count is caught before anything is allocated.
+					if (!readVarint(reader, count) || count / 8 > reader.getRemaining())
+					{
+						return false;
+					}
+
+					if constexpr (std::is_same_v<valueType, bool>)
+					{
+						const size_t size = static_cast<size_t>((count + 7) / 8);
+						if (size > reader.getRemaining())
+						{
+							return false;
+						}
+
+						const std::byte* bits = reader.it;
+						reader.it += size;
+						if constexpr (requires { data.push_back(true); })
+						{
+							data.clear();
+							for (uint64_t i = 0; i < count; i++)
+							{
+								data.push_back((static_cast<uint8_t>(bits[i / 8]) >> (i % 8)) & 1);
+							}
+						}
+						else
+						{
+							for (uint64_t i = 0; i < count && i < std::size(data); i++)
+							{
+								data[i] = (static_cast<uint8_t>(bits[i / 8]) >> (i % 8)) & 1;
+							}
+						}
+						return true;
+					}
+					else if constexpr (ManiZ::_impl::isVarint<valueType>)
+					{
+						using unsignedType = std::make_unsigned_t<valueType>;
+						uint8_t isSorted = 0;
+						if (!readScalar(reader, isSorted))
+						{
+							return false;
+						}
+
+						unsignedType previous = 0;
+						bool isFirst = true;
+						return readElements(data, count, [&](valueType& element)
+						{
+							// the first value of a sorted container is written like an unsorted one.
+							if (isSorted == 0 || isFirst)
+							{
+								isFirst = false;
+								const bool isValid = readCompactInteger(reader, element);
+								previous = static_cast<unsignedType>(element);
+								return isValid;
+							}
+
+							unsignedType delta = 0;
+							if (!readCompactInteger(reader, delta))
+							{
+								return false;
+							}
+							previous = static_cast<unsignedType>(previous + delta);
+							element = static_cast<valueType>(previous);
+							return true;
+						});
+					}
+					else if constexpr (std::ranges::contiguous_range<type> && std::is_arithmetic_v<valueType> && ManiZ::_impl::isBulkCopyable<valueType>())
+					{
+						// bytes and floating points are copied as they are.
+						return readBulk(reader, data, count);
+					}
+					else
+					{
+						return readElements(data, count, [&](auto& element)
+						{
+							return readCompact(reader, element);
+						});
+					}
+				}
+				else
+				{
+					// we're in an aggregate type
+					return RFL::visitMembers(data, [&](auto& ...members)
+					{
+						return (readCompact(reader, members) && ...);
+					});
+				}
+			}
+
+			template<typename T>
+			inline bool readCompactInteger(BinaryReader& reader, T& outValue)
+			{
+				using unsignedType = std::make_unsigned_t<T>;
+				uint64_t value = 0;
+				if (!readVarint(reader, value) || value > std::numeric_limits<unsignedType>::max())
+				{
+					return false;
+				}
+
+				if constexpr (std::is_signed_v<T>)
+				{
+					outValue = ManiZ::_impl::decodeZigzag(static_cast<unsignedType>(value));
+				}
+				else
+				{
+					outValue = static_cast<T>(value);
+				}
+				return true;
+			}
+
+			inline bool readBulk(BinaryReader& reader, auto& data, uint64_t count)
+			{
+				using valueType = std::ranges::range_value_t<std::remove_cvref_t<decltype(data)>>;
+				if (count > reader.getRemaining() / sizeof(valueType))
+				{
+					return false;
+				}
+
+				// the whole buffer is read at once, extra elements of fixed size containers are dropped.
+				size_t size = static_cast<size_t>(count);
+				if constexpr (requires { data.resize(size); })
+				{
+					data.resize(size);
+				}
+				else
+				{
+					size = std::min(size, std::size(data));
+				}
+
+				readBytes(reader, std::ranges::data(data), size * sizeof(valueType));
+				reader.it += (static_cast<size_t>(count) - size) * sizeof(valueType);
+				return true;
+			}
+
+			inline bool readElements(auto& data, uint64_t count, auto&& readElement)
+			{
+				using valueType = std::ranges::range_value_t<std::remove_cvref_t<decltype(data)>>;
+				if constexpr (requires { data.emplace_back(); })
+				{
+					data.clear();
+					for (uint64_t i = 0; i < count; i++)
+					{
+						if constexpr (std::is_same_v<valueType, bool>)
+						{
+							// vector<bool> hands out proxies instead of references.
+							bool value = false;
+							if (!readElement(value))
+							{
+								return false;
+							}
+							data.push_back(value);
+						}
+						else if (!readElement(data.emplace_back()))
+						{
+							return false;
+						}
+					}
+				}
+				else
+				{
+					// fixed size containers keep their size, extra elements are read and dropped.
+					for (uint64_t i = 0; i < count; i++)
+					{
+						valueType ignored{};
+						if (!readElement(i < std::size(data) ? data[i] : ignored))
+						{
+							return false;
+						}
+					}
+				}
+				return true;
+			}
+
+			inline bool readVarint(BinaryReader& reader, uint64_t& outValue)
+			{
+				if constexpr (std::endian::native == std::endian::little)
+				{
+					// swar fast path, any varint of up to 8 bytes is decoded from a single load without branching on each byte.
+					if (reader.getRemaining() >= sizeof(uint64_t))
+					{
+						uint64_t word = 0;
+						std::memcpy(&word, reader.it, sizeof(word));
+						const uint64_t lastBytes = ~word & 0x8080808080808080ull;
+						if (lastBytes != 0)
+						{
+							const uint32_t size = (std::countr_zero(lastBytes) + 1) / 8;
+							word &= size == 8 ? ~0ull : (1ull << (size * 8)) - 1;
+
+							// pack the 7 bits groups together: 2 groups per 16 bits, then 4 per 32 bits, then 8 per 64 bits.
+							word = ((word & 0x7F007F007F007F00ull) >> 1) | (word & 0x007F007F007F007Full);
+							word = ((word & 0x3FFF00003FFF0000ull) >> 2) | (word & 0x00003FFF00003FFFull);
+							word = ((word & 0x0FFFFFFF00000000ull) >> 4) | (word & 0x000000000FFFFFFFull);
+
+							outValue = word;
+							reader.it += size;
+							return true;
+						}
+					}
+				}
+
+				uint64_t value = 0;
+				for (uint32_t shift = 0; shift < 64; shift += 7)
+				{
+					if (reader.getRemaining() == 0)
+					{
+						return false;
+					}
+
+					const uint8_t byte = static_cast<uint8_t>(*reader.it++);
+					value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+					if ((byte & 0x80) == 0)
+					{
+						outValue = value;
+						return true;
+					}
+				}
+				return false;
+			}
+
+			// moves past a T without decoding it.
+			template<typename T>
+			inline bool skipBinary(BinaryReader& reader)
+			{
+				static_assert(!std::is_pointer_v<T>);
+
+				if constexpr (std::is_enum_v<T> || std::is_arithmetic_v<T> || ManiZ::_impl::isBulkCopyable<T>())
+				{
+					// bools are written as a uint8_t, enums have the size of their underlying type.
+					constexpr size_t size = std::is_same_v<T, bool> ? 1 : sizeof(T);
+					if (reader.getRemaining() < size)
+					{
+						return false;
+					}
+					reader.it += size;
+					return true;
+				}
+				else if constexpr (std::is_same_v<T, std::string>)
+				{
+					size_t size = 0;
+					if (!readSize(reader, size))
+					{
+						return false;
+					}
+					reader.it += size;
+					return true;
+				}
+				else if constexpr (std::ranges::range<T>)
+				{
+					uint64_t count = 0;
+					if (!readScalar(reader, count))
+					{
+						return false;
+					}
+
+					using valueType = std::ranges::range_value_t<T>;
+					if constexpr (std::ranges::contiguous_range<T> && ManiZ::_impl::isBulkCopyable<valueType>())
+					{
+						if (count > reader.getRemaining() / sizeof(valueType))
+						{
+							return false;
+						}
+						reader.it += static_cast<size_t>(count) * sizeof(valueType);
+						return true;
+					}
+					else
+					{
+						for (uint64_t i = 0; i < count; i++)
+						{
+							if (!skipBinary<valueType>(reader))
+							{
+								return false;
+							}
+						}
+						return true;
+					}
+				}
+				else
+				{
+					return []<typename ...M>(BinaryReader& reader, std::type_identity<std::tuple<M...>>)
+					{
+						return (skipBinary<M>(reader) && ...);
+					}(reader, std::type_identity<ManiZ::_impl::MemberTypes<T>>());
+				}
+			}
+
+			// scalars are decoded, strings become string_views and containers or aggregates become views.
+			template<typename T>
+			inline auto readView(BinaryReader& reader, bool isValid)
+			{
+				if constexpr (std::is_same_v<T, std::string>)
+				{
+					size_t size = 0;
+					if (!isValid || !readSize(reader, size))
+					{
+						return std::string_view();
+					}
+					return std::string_view(reinterpret_cast<const char*>(reader.it), size);
+				}
+				else if constexpr (std::ranges::range<T> || !(std::is_enum_v<T> || std::is_arithmetic_v<T>))
+				{
+					if (!isValid)
+					{
+						return view<T>();
+					}
+					return view<T>(std::span<const std::byte>(reader.it, reader.end));
+				}
+				else
+				{
+					T value{};
+					if (isValid)
+					{
+						readBinary(reader, value);
+					}
+					return value;
+				}
+			}
+		}
+
+		// fixed data must come from to::binary with the same T, nothing but the sizes is checked.
+		// tagged data only needs the members to keep their names and types.
+		template<class T>
+		inline T binary(std::span<const std::byte> data, EBinaryFormat format = EBinaryFormat::Fixed)
+		{
+			T obj{};
+			_impl::BinaryReader reader;
+			reader.begin = data.data();
+			reader.it = data.data();
+			reader.end = data.data() + data.size();
+
+			bool isValid = false;
+			if (format == EBinaryFormat::Tagged)
+			{
+				uint64_t fingerprint = 0;
+				isValid = _impl::readScalar(reader, fingerprint) && _impl::readTagged(reader, obj, fingerprint == ManiZ::_impl::getSchemaFingerprint<T>());
+			}
+			else if (format == EBinaryFormat::Compact)
+			{
+				isValid = _impl::readCompact(reader, obj);
+			}
+			else
+			{
+				isValid = _impl::readBinary(reader, obj);
+			}
+
+			if (!isValid)
+			{
+				_impl::reportError(reader);
+			}
+			return obj;
+		}
+	}
+
+	// reads members of a to::binary buffer in place, nothing is copied nor allocated.
+	// members are located on access by skipping the ones before them, so the buffer must outlive the view.
+	template<typename T>
+	class view
+	{
+	public:
+		view() = default;
+		explicit view(std::span<const std::byte> bytes) : m_bytes(bytes) {}
+
+		// the I-th member of an aggregate.
+		template<size_t I>
+		auto get() const requires (!std::ranges::range<T>)
+		{
+			using Members = ManiZ::_impl::MemberTypes<T>;
+			from::_impl::BinaryReader reader = makeReader();
+			const bool isValid = [&]<size_t ...J>(std::index_sequence<J...>)
+			{
+				return (from::_impl::skipBinary<std::tuple_element_t<J, Members>>(reader) && ...);
+			}(std::make_index_sequence<I>());
+			return from::_impl::readView<std::tuple_element_t<I, Members>>(reader, isValid);
+		}
+
+		size_t size() const requires std::ranges::range<T>
+		{
+			from::_impl::BinaryReader reader = makeReader();
+			uint64_t count = 0;
+			return from::_impl::readScalar(reader, count) ? static_cast<size_t>(count) : 0;
+		}
+
+		// the index-th element of a container, elements that aren't bulk copyable are skipped one by one.
+		auto operator[](size_t index) const requires std::ranges::range<T>
+		{
+			using valueType = std::ranges::range_value_t<T>;
+			from::_impl::BinaryReader reader = makeReader();
+			uint64_t count = 0;
+			bool isValid = from::_impl::readScalar(reader, count) && index < count;
+			if constexpr (std::ranges::contiguous_range<T> && ManiZ::_impl::isBulkCopyable<valueType>())
+			{
+				isValid = isValid && index < reader.getRemaining() / sizeof(valueType);
+				reader.it += isValid ? index * sizeof(valueType) : 0;
+			}
+			else
+			{
+				for (size_t i = 0; isValid && i < index; i++)
+				{
+					isValid = from::_impl::skipBinary<valueType>(reader);
+				}
+			}
+			return from::_impl::readView<valueType>(reader, isValid);
+		}
+
+		// contiguous containers of bulk copyable values. The binary format has no alignment, the span is only
+		// handed out when the elements are aligned for their type in the buffer, otherwise (or when the data is
+		// invalid) this returns nullopt and operator[] still reads them one by one.
+		auto getSpan() const requires std::ranges::contiguous_range<T> && (ManiZ::_impl::isBulkCopyable<std::ranges::range_value_t<T>>())
+		{
+			using valueType = std::ranges::range_value_t<T>;
+			from::_impl::BinaryReader reader = makeReader();
+			uint64_t count = 0;
+			if (!from::_impl::readScalar(reader, count) || count > reader.getRemaining() / sizeof(valueType)
+				|| reinterpret_cast<uintptr_t>(reader.it) % alignof(valueType) != 0)
+			{
+				return std::optional<std::span<const valueType>>();
+			}
+			return std::optional<std::span<const valueType>>(std::span<const valueType>(reinterpret_cast<const valueType*>(reader.it), static_cast<size_t>(count)));
+		}
+
+		std::span<const std::byte> getBytes() const { return m_bytes; }
+
+	private:
+		from::_impl::BinaryReader makeReader() const
+		{
+			from::_impl::BinaryReader reader;
+			reader.begin = m_bytes.data();
+			reader.it = m_bytes.data();
+			reader.end = m_bytes.data() + m_bytes.size();
+			return reader;
+		}
+
+		std::span<const std::byte> m_bytes;
+	};
+}
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <ManiZ/Json.h>
+#include <ManiZ/Sink.h>
+#include <filesystem>
+#include <string_view>
+#include <span>
+#include <format>
+#include <iostream>
+#include <utility>
+
+#if defined(_WIN32)
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+	#include <io.h>
+	#include <fcntl.h>
+	#include <sys/stat.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <cerrno>
+#endif
+
+namespace ManiZ
+{
+	// read only mapping of a whole file, the pages are loaded by the os as they're read instead of being copied up front.
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+
+		explicit MappedFile(const std::filesystem::path& path)
+		{
+#if defined(_WIN32)
+			HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
+			{
+				reportError(path);
+				return;
+			}
+
+			LARGE_INTEGER size = {};
+			const bool hasSize = GetFileSizeEx(file, &size) != 0;
+			if (hasSize && size.QuadPart > 0)
+			{
+				HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				if (mapping != nullptr)
+				{
+					// the view keeps the mapping alive, the handles aren't needed anymore.
+					m_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+					m_size = m_data != nullptr ? static_cast<size_t>(size.QuadPart) : 0;
+					CloseHandle(mapping);
+				}
+			}
+			m_isOpen = hasSize && (size.QuadPart == 0 || m_data != nullptr);
+			CloseHandle(file);
+#else
+			const int file = ::open(path.c_str(), O_RDONLY);
+			if (file < 0)
+			{
+				reportError(path);
+				return;
+			}
+
+			struct stat status = {};
+			const bool hasSize = ::fstat(file, &status) == 0;
+			if (hasSize && status.st_size > 0)
+			{
+				void* data = ::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+				if (data != MAP_FAILED)
+				{
+					// parsers read from the start to the end, the os can read ahead aggressively.
+					::madvise(data, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+					m_data = static_cast<const char*>(data);
+					m_size = static_cast<size_t>(status.st_size);
+				}
+			}
+			m_isOpen = hasSize && (status.st_size == 0 || m_data != nullptr);
+			// the mapping stays valid once the file is closed.
+			::close(file);
+#endif
+			if (!m_isOpen)
+			{
+				reportError(path);
+			}
+		}
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		MappedFile(MappedFile&& other) noexcept
+			: m_data(std::exchange(other.m_data, nullptr))
+			, m_size(std::exchange(other.m_size, 0))
+			, m_isOpen(std::exchange(other.m_isOpen, false))
+		{
+		}
+
+		MappedFile& operator=(MappedFile&& other) noexcept
+		{
+			if (this != &other)
+			{
+				unmap();
+				m_data = std::exchange(other.m_data, nullptr);
+				m_size = std::exchange(other.m_size, 0);
+				m_isOpen = std::exchange(other.m_isOpen, false);
+			}
+			return *this;
+		}
+
+		~MappedFile() { unmap(); }
+
+		// empty files are open but have no data.
+		bool isOpen() const { return m_isOpen; }
+		std::string_view getView() const { return std::string_view(m_data, m_size); }
+		std::span<const std::byte> getBytes() const { return std::span<const std::byte>(reinterpret_cast<const std::byte*>(m_data), m_size); }
+
+	private:
+		void unmap()
+		{
+			if (m_data != nullptr)
+			{
+#if defined(_WIN32)
+				UnmapViewOfFile(m_data);
+#else
+				::munmap(const_cast<char*>(m_data), m_size);
+#endif
+			}
+			m_data = nullptr;
+			m_size = 0;
+			m_isOpen = false;
+		}
+
+		static void reportError(const std::filesystem::path& path)
+		{
+			std::cout << std::format("[ManiZ::file]: failed to map {}", path.string()) << std::endl;
+		}
+
+		const char* m_data = nullptr;
+		size_t m_size = 0;
+		bool m_isOpen = false;
+	};
+
+	namespace from
+	{
+		// parses straight from the file's mapping, the file is never copied into a string.
+		template<class T>
+		inline T jsonFile(const std::filesystem::path& path)
+		{
+			const MappedFile file(path);
+			return file.isOpen() ? json<T>(file.getView()) : T();
+		}
+
+		inline JsonObject parseFile(const std::filesystem::path& path, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+		{
+			const MappedFile file(path);
+			return file.isOpen() ? parse(file.getView(), resource) : JsonObject();
+		}
+	}
+
+	namespace to
+	{
+		// the json is streamed to the file through a fixed size buffer, each flush is a positioned write.
+		inline bool jsonFile(const std::filesystem::path& path, const auto& data, EJsonFormat format = EJsonFormat::Pretty)
+		{
+#if defined(_WIN32)
+			const int file = _wopen(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY | _O_SEQUENTIAL, _S_IREAD | _S_IWRITE);
+#else
+			const int file = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+			if (file < 0)
+			{
+				std::cout << std::format("[ManiZ::file]: failed to open {}", path.string()) << std::endl;
+				return false;
+			}
+
+			bool isValid = false;
+			{
+#if defined(_WIN32)
+				BufferedSink sink(file);
+#else
+				size_t offset = 0;
+				BufferedSink sink([file, &offset](std::string_view data)
+				{
+					// pwrite doesn't move the file offset, the writes can't interleave with other users of the descriptor.
+					while (!data.empty())
+					{
+						const ssize_t written = ::pwrite(file, data.data(), data.size(), static_cast<off_t>(offset));
+						if (written < 0 && errno == EINTR)
+						{
+							continue;
+						}
+						if (written <= 0)
+						{
+							return false;
+						}
+						offset += static_cast<size_t>(written);
+						data.remove_prefix(static_cast<size_t>(written));
+					}
+					return true;
+				});
+#endif
+				isValid = json(sink, data, format);
+			}
+
+#if defined(_WIN32)
+			isValid = _close(file) == 0 && isValid;
+#else
+			isValid = ::close(file) == 0 && isValid;
+#endif
+			return isValid;
+		}
+	}
+}
@@ -2,16 +2,42 @@
 
 #include <ManiZ/Reflection.h>
 #include <ManiZ/Traits.h>
+#include <ManiZ/Simd.h>
+#include <ManiZ/Sink.h>
 #include <vector>
-#include <map>
 #include <string>
+#include <string_view>
+#include <memory_resource>
+#include <memory>
+#include <utility>
 #include <format>
 #include <algorithm>
 #include <assert.h>
 #include <ranges>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <cmath>
+#include <array>
+#include <bit>
+#include <tuple>
+#include <istream>
+#include <ostream>
+#include <iterator>
+#include <thread>
+#include <span>
+#include <bitset>
 
 namespace ManiZ
 {
+	enum class EJsonFormat : uint8_t
+	{
+		// one member per line, indented with tabs.
+		Pretty,
+		// no whitespace at all, smallest output.
+		Compact,
+	};
+
 	namespace to
 	{
 		namespace _impl
@@ -20,591 +46,2825 @@ namespace ManiZ
 			struct JsonSerializationState
 			{
 				uint32_t indent = 0;
-				std::vector<std::vector<std::string>> namestack;
-				std::vector<size_t> offsetStack;
-
-				std::string safeGetBackName()
-				{
-					if (namestack.size() > 0)
-					{
-						return namestack.back()[offsetStack.back()];
-					}
-					else
-					{
-						return "";
-					}
-				};
-
-				void safeIncrementBackOffset()
-				{
-					if (offsetStack.size() > 0)
-					{
-						offsetStack.back()++;
-					}
-				};
+				EJsonFormat format = EJsonFormat::Pretty;
+				// large ranges are split among this many threads.
+				uint32_t threadCount = 1;
 			};
 
-			inline std::string serializeMany(JsonSerializationState& state, const auto& first, const auto& ...others);
-			inline std::string serializeMany(JsonSerializationState& state);
-			inline std::string serialize(JsonSerializationState& state, const auto& data, bool isInContainer = false);
-			inline void addIndent(std::string& s, uint32_t indent);
+			// the output buffer only needs push_back(char) and append(std::string_view), values are appended in place.
+			template<typename T, size_t ...I>
+			inline void serializeMembers(JsonSerializationState& state, auto& out, std::index_sequence<I...>, const auto& ...members);
+			inline void serialize(JsonSerializationState& state, auto& out, const auto& data);
+			inline bool serializeElementsParallel(JsonSerializationState& state, auto& out, const auto& data);
+			inline void appendChunks(auto& out, std::span<const std::string> chunks);
+			inline void beginElement(JsonSerializationState& state, auto& out, size_t index);
+			inline void endContainer(JsonSerializationState& state, auto& out, size_t count, char closingCharacter);
+			inline void addIndent(auto& out, uint32_t indent);
+			inline void writeKey(JsonSerializationState& state, auto& out, std::string_view key);
+			inline void writeString(auto& out, std::string_view data);
 			template<typename T>
-			inline std::string format(const T& data);
+			inline void format(auto& out, const T& data);
 
-			inline std::string serializeMany(JsonSerializationState& state) { return ""; }
-
-			inline std::string serializeMany(JsonSerializationState& state, const auto& first, const auto& ...others)
+			template<typename T, size_t ...I>
+			inline void serializeMembers(JsonSerializationState& state, auto& out, std::index_sequence<I...>, const auto& ...members)
 			{
-				return serialize(state, first) + serializeMany(state, others...);
+				// member names are resolved at compile time from the type's name table.
+				constexpr auto& names = RFL::getMemberNameTable<T>();
+				const auto serializeMember = [&](size_t index, const auto& member)
+				{
+					beginElement(state, out, index);
+					writeKey(state, out, names[index]);
+					serialize(state, out, member);
+				};
+				(serializeMember(I, members), ...);
 			}
 
-			inline std::string serialize(JsonSerializationState& state, const auto& data, bool isInContainer)
+			inline void serialize(JsonSerializationState& state, auto& out, const auto& data)
 			{
-				std::string s;
-				addIndent(s, state.indent);
-
 				using type = std::remove_cvref_t<decltype(data)>;
 				static_assert(!std::is_pointer_v<type>);
 
-				const std::string name = isInContainer ? "" : state.safeGetBackName();
-
-				const auto write = [&](const std::string& key, const std::string& value)
-				{
-					if (isInContainer)
-					{
-						// we're in an array-like container, no key needed
-						s += std::format("{},\n", value);
-					}
-					else
-					{
-						s += std::format("\"{}\": {},\n", key, value);
-					}
-				};
-
-				if constexpr (std::is_fundamental_v<type>)
+				if constexpr (std::is_fundamental_v<type> || ManiZ::is_string<type>::value)
 				{
-					write(name, format(data));
+					format(out, data);
 				}
 				else if constexpr (std::is_enum_v<type>)
 				{
-					write(name, format(static_cast<long>(data)));
-				}
-				else if constexpr (ManiZ::is_string<type>::value)
-				{
-					write(name, format(data));
+					format(out, static_cast<long>(data));
 				}
 				else if constexpr (std::ranges::range<type>)
 				{
-					if (!name.empty())
-					{
-						s += std::format("\"{}\": ", name);
-					}
-					else
-					{
-						addIndent(s, 1); // special formatting for nested arrays.
-						state.indent++;
-					}
-
 					// hard iterate over the container
-					s += std::format("[\n");
+					out.push_back('[');
 					state.indent++;
-					for (const auto& v : data)
+					size_t count = 0;
+					if constexpr (std::ranges::random_access_range<type> && std::ranges::sized_range<type>)
 					{
-						s += serialize(state, v, true);
+						if (serializeElementsParallel(state, out, data))
+						{
+							count = std::ranges::size(data);
+						}
 					}
-					state.indent--;
-					
-					addIndent(s, state.indent);
 
-					if (name.empty())
+					if (count == 0)
 					{
-						state.indent--;
+						for (const auto& v : data)
+						{
+							beginElement(state, out, count++);
+							serialize(state, out, v);
+						}
 					}
-					s += std::format("],\n");
+					state.indent--;
+					endContainer(state, out, count, ']');
 				}
 				else
 				{
 					// we're in an aggregate type
-					// push the member names in the stack
-					auto memberNames = RFL::getMemberNames<type>();
-					std::reverse(memberNames.begin(), memberNames.end());
-					state.namestack.push_back(memberNames);
-					state.offsetStack.push_back(0);
-
-					if (name.empty())
-					{
-						s += "{\n";
-					}
-					else
-					{
-						// if we're already in an aggregate type, we want to output the key
-						s += std::format("\"{}\":", name) + " {\n";
-					}
-					
+					out.push_back('{');
 					state.indent++;
-					
 					RFL::visitMembers(data, [&](auto& ...members)
 					{
 						// recursively serialize the members.
-						s += serializeMany(state, members...);
+						serializeMembers<type>(state, out, std::index_sequence_for<decltype(members)...>(), members...);
 					});
-					
 					state.indent--;
-					addIndent(s, state.indent);
-					
-					s += "},\n";
+					endContainer(state, out, RFL::memberCount<type>(), '}');
+				}
+			}
+
+			inline bool serializeElementsParallel(JsonSerializationState& state, auto& out, const auto& data)
+			{
+				// below this, starting threads costs more than writing the elements.
+				constexpr size_t minElementsPerThread = 256;
+
+				const size_t count = std::ranges::size(data);
+				const size_t chunkCount = std::clamp<size_t>(count / minElementsPerThread, 1, state.threadCount);
+				if (chunkCount < 2)
+				{
+					return false;
+				}
+
+				// every chunk is written to its own buffer, with the same separators and indentation as the serial path.
+				std::vector<std::string> chunks(chunkCount);
+				const auto serializeChunk = [&](size_t chunk)
+				{
+					JsonSerializationState chunkState = state;
+					chunkState.threadCount = 1;
+					const size_t end = (chunk + 1) * count / chunkCount;
+					for (size_t i = chunk * count / chunkCount; i < end; i++)
+					{
+						beginElement(chunkState, chunks[chunk], i);
+						serialize(chunkState, chunks[chunk], data[i]);
+					}
+				};
+
+				std::vector<std::thread> threads;
+				threads.reserve(chunkCount - 1);
+				for (size_t chunk = 1; chunk < chunkCount; chunk++)
+				{
+					threads.emplace_back(serializeChunk, chunk);
+				}
+				serializeChunk(0);
+				for (std::thread& thread : threads)
+				{
+					thread.join();
+				}
 
-					// pop the name stack
-					state.namestack.pop_back();
-					state.offsetStack.pop_back();
+				appendChunks(out, chunks);
+				return true;
+			}
+
+			inline void appendChunks(auto& out, std::span<const std::string> chunks)
+			{
+				// sinks can write the chunks as they are, without copying them into one buffer first.
+				if constexpr (requires { out.appendChunks(chunks); })
+				{
+					out.appendChunks(chunks);
+				}
+				else
+				{
+					for (const std::string& chunk : chunks)
+					{
+						out.append(chunk);
+					}
 				}
+			}
 
-				if (!isInContainer)
+			inline void beginElement(JsonSerializationState& state, auto& out, size_t index)
+			{
+				// separators only go between elements, json doesn't allow trailing commas.
+				if (index > 0)
 				{
-					// if we're in a container we don't need to increment the offset as we're hard iterating
-					state.safeIncrementBackOffset();
+					out.push_back(',');
 				}
 
-				return s;
+				if (state.format == EJsonFormat::Pretty)
+				{
+					out.push_back('\n');
+					addIndent(out, state.indent);
+				}
 			}
 
-			inline void addIndent(std::string& s, uint32_t indent)
+			inline void endContainer(JsonSerializationState& state, auto& out, size_t count, char closingCharacter)
 			{
-				for (uint32_t i = 0; i < indent; i++)
+				if (state.format == EJsonFormat::Pretty && count > 0)
 				{
-					s += "\t";
+					out.push_back('\n');
+					addIndent(out, state.indent);
 				}
+				out.push_back(closingCharacter);
 			}
 
-			template<typename T>
-			inline std::string format(const T& data)
+			inline void addIndent(auto& out, uint32_t indent)
 			{
-				return std::format("{}", data);
+				for (uint32_t i = 0; i < indent; i++)
+				{
+					out.push_back('\t');
+				}
 			}
 
-			template<>
-			inline std::string format<float>(const float& data)
+			inline void writeKey(JsonSerializationState& state, auto& out, std::string_view key)
 			{
-				return std::format("{:f}", data);
+				writeString(out, key);
+				out.push_back(':');
+				if (state.format == EJsonFormat::Pretty)
+				{
+					out.push_back(' ');
+				}
 			}
 
-			template<>
-			inline std::string format<double>(const double& data)
+			inline void writeString(auto& out, std::string_view data)
 			{
-				return std::format("{:f}", data);
+				constexpr std::string_view hexDigits = "0123456789abcdef";
+
+				out.push_back('"');
+				// characters that don't need escaping are appended in runs.
+				size_t runStart = 0;
+				for (size_t i = 0; i < data.size(); i++)
+				{
+					const unsigned char c = static_cast<unsigned char>(data[i]);
+					if (c >= 0x20 && c != '"' && c != '\\')
+					{
+						continue;
+					}
+
+					out.append(data.substr(runStart, i - runStart));
+					runStart = i + 1;
+
+					out.push_back('\\');
+					switch (c)
+					{
+						case '"':	out.push_back('"'); break;
+						case '\\':	out.push_back('\\'); break;
+						case '\n':	out.push_back('n'); break;
+						case '\r':	out.push_back('r'); break;
+						case '\t':	out.push_back('t'); break;
+						case '\b':	out.push_back('b'); break;
+						case '\f':	out.push_back('f'); break;
+						default:
+							out.append("u00");
+							out.push_back(hexDigits[c >> 4]);
+							out.push_back(hexDigits[c & 0xF]);
+							break;
+					}
+				}
+				out.append(data.substr(runStart));
+				out.push_back('"');
 			}
 
-			template<>
-			inline std::string format(const std::string& data)
+			template<typename T>
+			inline void format(auto& out, const T& data)
 			{
-				return std::format("\"{}\"", data);
-			}			
+				if constexpr (ManiZ::is_string<T>::value)
+				{
+					writeString(out, data);
+				}
+				else if constexpr (std::is_same_v<T, bool>)
+				{
+					out.append(data ? std::string_view("true") : std::string_view("false"));
+				}
+				else
+				{
+					// shortest representation that round-trips, large enough for any 64 bits integer or double.
+					char buffer[32];
+					const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), data);
+					assert(result.ec == std::errc());
+					out.append(std::string_view(buffer, result.ptr - buffer));
+				}
+			}
 		}
 
-		inline std::string json(const auto& ...data)
+		// appends the json representation of data to out, the buffer can be reused across calls to avoid reallocations.
+		// the format isn't defaulted, json(someString, format) has to serialize the string instead of appending a number to it.
+		inline void json(std::string& out, const auto& data, EJsonFormat format)
 		{
 			_impl::JsonSerializationState state;
-			std::string s = _impl::serializeMany(state, data...);
-			s.pop_back();
-			s.pop_back();
-			return s;
+			state.format = format;
+			_impl::serialize(state, out, data);
 		}
-	}
 
-	namespace _impl
-	{
-		using json_variant = std::variant<long long, unsigned long long, double, std::string, bool>;
-	}
-
-	class JsonObject
-	{
-	public:
-		JsonObject() = default;
-
-		JsonObject(const auto& in)
+		// streams the json representation of data through the sink's buffer, the whole document never is in memory.
+		// returns false if the sink failed to write. Like for strings, the format is required.
+		inline bool json(BufferedSink& sink, const auto& data, EJsonFormat format)
 		{
-			m_isValid = true;
-			m_value = in;
+			_impl::JsonSerializationState state;
+			state.format = format;
+			_impl::serialize(state, sink, data);
+			return sink.flush();
 		}
 
-		JsonObject(const std::vector<JsonObject>& in)
+		inline bool json(std::ostream& out, const auto& data, EJsonFormat format)
 		{
-			m_isValid = true;
-			m_array = in;
+			BufferedSink sink(out);
+			return json(sink, data, format);
 		}
 
-		template<typename T> 
-		T get() const;
-
-		template<typename T>
-		requires std::is_integral_v<T> && std::is_unsigned_v<T>
-		T get() const
+		inline std::string json(const auto& data, EJsonFormat format = EJsonFormat::Pretty)
 		{
-			return static_cast<T>(std::get<unsigned long long>(m_value));
+			std::string s;
+			json(s, data, format);
+			return s;
 		}
 
-		template<typename T>
-		requires (std::is_integral_v<T> && !std::is_unsigned_v<T>) || std::is_enum_v<T>
-		T get() const
+		// same output as json, but large ranges are written by several threads.
+		inline void jsonParallel(std::string& out, const auto& data, EJsonFormat format, uint32_t threadCount = std::thread::hardware_concurrency())
 		{
-			// we deserialize to long only if the value is negative, otherwise it is set to the unsigned long slot of the variant.
-			if (const long long* value = std::get_if<long long>(&m_value))
-			{
-				return static_cast<T>(*value);
-			}
-			return static_cast<T>(std::get<unsigned long long>(m_value));
+			_impl::JsonSerializationState state;
+			state.format = format;
+			state.threadCount = std::max(threadCount, 1u);
+			_impl::serialize(state, out, data);
 		}
 
-		template<typename T>
-		requires std::is_floating_point_v<T>
-		T get() const
+		// sinks opened on a file descriptor write the threads' buffers with a single vectored write.
+		inline bool jsonParallel(BufferedSink& sink, const auto& data, EJsonFormat format, uint32_t threadCount = std::thread::hardware_concurrency())
 		{
-			return static_cast<T>(std::get<double>(m_value));
+			_impl::JsonSerializationState state;
+			state.format = format;
+			state.threadCount = std::max(threadCount, 1u);
+			_impl::serialize(state, sink, data);
+			return sink.flush();
 		}
 
-		template<>
-		bool get<bool>() const
+		inline std::string jsonParallel(const auto& data, EJsonFormat format = EJsonFormat::Pretty, uint32_t threadCount = std::thread::hardware_concurrency())
 		{
-			return std::get<bool>(m_value);
+			std::string s;
+			jsonParallel(s, data, format, threadCount);
+			return s;
 		}
 
-		template<>
-		std::string get<std::string>() const
+		namespace _impl
 		{
-			return std::get<std::string>(m_value);
+			inline void writeLines(auto& out, const std::ranges::range auto& records)
+			{
+				JsonSerializationState state;
+				state.format = EJsonFormat::Compact;
+				for (const auto& record : records)
+				{
+					serialize(state, out, record);
+					out.push_back('\n');
+				}
+			}
 		}
 
-		const std::vector<JsonObject>& getArray() const
+		// json lines: one compact record per line.
+		inline void jsonLines(std::string& out, const std::ranges::range auto& records)
 		{
-			return m_array;
+			_impl::writeLines(out, records);
 		}
 
-		const JsonObject& getAt(size_t index) const
+		inline bool jsonLines(BufferedSink& sink, const std::ranges::range auto& records)
 		{
-			assert(index >= 0 && index < m_keysInOrder.size());
-			return m_members.at(m_keysInOrder[index]);
+			_impl::writeLines(sink, records);
+			return sink.flush();
 		}
 
-		JsonObject& operator[](const std::string& key) 
+		inline bool jsonLines(std::ostream& out, const std::ranges::range auto& records, size_t bufferSize = BufferedSink::DefaultBufferSize)
 		{
-			if (!has(key))
-			{
-				m_keysInOrder.push_back(key);
-			}
-			return m_members[key]; 
+			BufferedSink sink(out, bufferSize);
+			return jsonLines(sink, records);
 		}
 
-		bool has(const std::string& key) const
+		inline std::string jsonLines(const std::ranges::range auto& records)
 		{
-			return m_members.contains(key);
+			std::string s;
+			jsonLines(s, records);
+			return s;
 		}
+	}
 
-		const JsonObject& operator[](const std::string& key) const { return m_members.at(key); }
-		size_t size() const { return m_members.size(); }
-		bool isValid() const { return m_isValid || m_members.size() > 0 || m_members.size() > 0; }
-	private:
-		_impl::json_variant m_value;
-		std::vector<std::string> m_keysInOrder;
-		std::vector<JsonObject> m_array;
-		std::map<std::string, JsonObject> m_members;
-		bool m_isValid = false;
+	enum class EJsonType : uint8_t
+	{
+		Null,
+		Integer,
+		Unsigned,
+		Float,
+		Boolean,
+		String,
+		Array,
+		Object,
 	};
 
-	namespace from
+	namespace _impl
 	{
-		// json parser
-		namespace _impl
+		// bump allocator that keeps its blocks when it's reset, so that repeated parses stop allocating once it's warm.
+		class JsonArena : public std::pmr::memory_resource
 		{
-			struct JsonParser
+		public:
+			explicit JsonArena(size_t blockSize = 64 * 1024) : m_blockSize(blockSize) {}
+			JsonArena(const JsonArena&) = delete;
+			JsonArena& operator=(const JsonArena&) = delete;
+
+			~JsonArena()
 			{
-				std::string::const_iterator it;
-				size_t line = 0;
-				size_t column = 0;
+				for (const Block& block : m_blocks)
+				{
+					::operator delete(block.data);
+				}
+			}
+
+			// everything allocated so far is released at once, the blocks are kept for the next allocations.
+			void reset()
+			{
+				m_current = 0;
+				m_offset = 0;
+			}
+
+		private:
+			struct Block
+			{
+				std::byte* data = nullptr;
+				size_t size = 0;
+			};
 
-				void inc()
+			void* do_allocate(size_t bytes, size_t alignment) override
+			{
+				assert(alignment <= alignof(std::max_align_t));
+				while (m_current < m_blocks.size())
 				{
-					if (*it == '\n')
-					{
-						column = 0;
-						line++;
-					}
-					else
+					const Block& block = m_blocks[m_current];
+					const size_t offset = (m_offset + alignment - 1) & ~(alignment - 1);
+					if (offset + bytes <= block.size)
 					{
-						column++;
+						m_offset = offset + bytes;
+						return block.data + offset;
 					}
-					it++;
+
+					m_current++;
+					m_offset = 0;
 				}
 
-				char get() const { return *it; }
-			};
+				// none of the kept blocks has enough room left, blocks grow geometrically.
+				const size_t size = std::max(bytes, m_blocks.empty() ? m_blockSize : m_blocks.back().size * 2);
+				m_blocks.push_back({ static_cast<std::byte*>(::operator new(size)), size });
+				m_current = m_blocks.size() - 1;
+				m_offset = bytes;
+				return m_blocks.back().data;
+			}
 
-			inline JsonObject parseMany(JsonParser& parser, const std::string& text);
-			inline JsonObject parse(JsonParser& parser, const std::string& text);
-			inline void skipWhitespaces(JsonParser& parser, const std::string& text);
-			inline JsonObject error(const JsonParser& parser);
+			// memory is only given back when the arena is reset.
+			void do_deallocate(void*, size_t, size_t) override {}
 
-			inline JsonObject parseMany(JsonParser& parser, const std::string& text)
+			bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
 			{
-				if (parser.get() != '{')
-				{
-					return error(parser);
-				}
+				return this == &other;
+			}
 
-				parser.inc();
+			std::vector<Block> m_blocks;
+			size_t m_current = 0;
+			size_t m_offset = 0;
+			size_t m_blockSize = 0;
+		};
+	}
 
-				JsonObject obj;
-				while (parser.it != text.end() && parser.get() != '}')
-				{
-					skipWhitespaces(parser, text);
+	// a json value is a type tag next to an 8 bytes payload: scalars are stored inline,
+	// strings, arrays and objects point to their storage. Object members are kept contiguous, in insertion order.
+	// storage is allocated from a std::pmr::memory_resource, which lets a whole document live in an arena.
+	class JsonObject
+	{
+	public:
+		using Member = std::pair<std::pmr::string, JsonObject>;
 
-					if (parser.get() != '"')
-					{
-						// we expect a key
-						return error(parser);
-					}
+		JsonObject() = default;
 
-					// skip "
-					parser.inc();
+		explicit JsonObject(EJsonType type, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+		{
+			m_type = type;
+			switch (type)
+			{
+				case EJsonType::String:	m_string = create<std::pmr::string>(resource); break;
+				case EJsonType::Array:	m_array = create<std::pmr::vector<JsonObject>>(resource); break;
+				case EJsonType::Object:	m_members = create<std::pmr::vector<Member>>(resource); break;
+				default:				m_unsigned = 0; break;
+			}
+		}
 
-					const std::string::const_iterator start = parser.it;
-					while (parser.get() != '"' && parser.it != text.end())
-					{
-						parser.inc();
-					}
-					
-					std::string key = text.substr(start - text.begin(), parser.it - start);
-					
-					parser.inc();
-					skipWhitespaces(parser, text);
-					if (parser.get() != ':')
-					{
-						// we expect a : between keys and values
-						return error(parser);
-					}
+		template<typename T>
+		requires std::is_same_v<T, bool>
+		explicit JsonObject(T in) : m_boolean(in), m_type(EJsonType::Boolean) {}
 
-					parser.inc();
-					skipWhitespaces(parser, text);
-					
-					obj[key] = parse(parser, text);
-					if (!obj[key].isValid())
-					{
-						return error(parser);
-					}
+		template<typename T>
+		requires std::is_integral_v<T> && std::is_signed_v<T>
+		explicit JsonObject(T in) : m_integer(in), m_type(EJsonType::Integer) {}
 
-					parser.inc();
-					skipWhitespaces(parser, text);
-					if (parser.get() == ',')
-					{
-						parser.inc();
-					}
-					skipWhitespaces(parser, text);
-				}
-				return obj;
+		template<typename T>
+		requires std::is_integral_v<T> && std::is_unsigned_v<T> && (!std::is_same_v<T, bool>)
+		explicit JsonObject(T in) : m_unsigned(in), m_type(EJsonType::Unsigned) {}
+
+		template<typename T>
+		requires std::is_floating_point_v<T>
+		explicit JsonObject(T in) : m_float(in), m_type(EJsonType::Float) {}
+
+		explicit JsonObject(std::string_view in, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			: m_string(create<std::pmr::string>(resource, in)), m_type(EJsonType::String) {}
+		explicit JsonObject(const char* in) : JsonObject(std::string_view(in)) {}
+		explicit JsonObject(const std::string& in) : JsonObject(std::string_view(in)) {}
+		// the storage is adopted when it comes from a memory resource, nothing is copied.
+		explicit JsonObject(std::pmr::string&& in)
+			: m_string(create<std::pmr::string>(in.get_allocator().resource(), std::move(in))), m_type(EJsonType::String) {}
+		explicit JsonObject(const std::vector<JsonObject>& in)
+			: m_array(create<std::pmr::vector<JsonObject>>(std::pmr::get_default_resource(), in.begin(), in.end())), m_type(EJsonType::Array) {}
+		explicit JsonObject(std::pmr::vector<JsonObject>&& in)
+			: m_array(create<std::pmr::vector<JsonObject>>(in.get_allocator().resource(), std::move(in))), m_type(EJsonType::Array) {}
+
+		JsonObject(const JsonObject& other) { copyFrom(other); }
+		JsonObject(JsonObject&& other) noexcept { moveFrom(other); }
+		~JsonObject() { destroy(); }
+
+		JsonObject& operator=(const JsonObject& other)
+		{
+			if (this != &other)
+			{
+				destroy();
+				copyFrom(other);
 			}
+			return *this;
+		}
 
-			inline JsonObject parse(JsonParser& parser, const std::string& text)
+		JsonObject& operator=(JsonObject&& other) noexcept
+		{
+			if (this != &other)
 			{
-				if (parser.get() == '{')
-				{
-					return parseMany(parser, text);
-				} 
-				else if (parser.get() == '[')
+				destroy();
+				moveFrom(other);
+			}
+			return *this;
+		}
+
+		// whether get<T> can read the value, numbers convert between each other.
+		template<typename T>
+		bool is() const
+		{
+			if constexpr (std::is_same_v<T, bool>)
+			{
+				return m_type == EJsonType::Boolean;
+			}
+			else if constexpr (std::is_enum_v<T>)
+			{
+				return is<std::underlying_type_t<T>>();
+			}
+			else if constexpr (std::is_integral_v<T>)
+			{
+				// numbers that don't fit T are a mismatch, casting them would be undefined.
+				switch (m_type)
 				{
-					// array
-					parser.inc();
-					std::vector<JsonObject> vec;
-					while (parser.get() != ']' && parser.it != text.end())
-					{
-						skipWhitespaces(parser, text);
-						vec.push_back(parse(parser, text));
-						parser.inc();
-						if (parser.get() == ',')
-						{
-							parser.inc();
-						}
-						skipWhitespaces(parser, text);
-					}
-					return JsonObject(vec);
+					case EJsonType::Integer:	return m_integer < 0 ? std::is_signed_v<T> && m_integer >= static_cast<int64_t>(std::numeric_limits<T>::min()) : static_cast<uint64_t>(m_integer) <= static_cast<uint64_t>(std::numeric_limits<T>::max());
+					case EJsonType::Unsigned:	return m_unsigned <= static_cast<uint64_t>(std::numeric_limits<T>::max());
+					case EJsonType::Float:		return std::trunc(m_float) == m_float && m_float >= static_cast<double>(std::numeric_limits<T>::min()) && m_float < std::ldexp(1.0, std::numeric_limits<T>::digits);
+					default:					return false;
 				}
-				else if (parser.get() == '"')
+			}
+			else if constexpr (std::is_floating_point_v<T>)
+			{
+				if (m_type == EJsonType::Float)
 				{
-					// string
-					parser.inc();
-					const std::string::const_iterator start = parser.it;
-					while (parser.get() != '"' && parser.it != text.end())
-					{
-						parser.inc();
-					}
+					return std::abs(m_float) <= static_cast<double>(std::numeric_limits<T>::max());
+				}
+				return m_type == EJsonType::Integer || m_type == EJsonType::Unsigned;
+			}
+			else
+			{
+				return m_type == EJsonType::String;
+			}
+		}
+
+		// values of another type, or numbers that don't fit T, return T().
+		template<typename T>
+		T get() const
+		{
+			if (!is<T>())
+			{
+				return T();
+			}
 
-					std::string value = text.substr(start - text.begin(), parser.it - start);
-					return JsonObject(value);
+			if constexpr (std::is_same_v<T, bool>)
+			{
+				return m_boolean;
+			}
+			else if constexpr (std::is_integral_v<T> || std::is_enum_v<T> || std::is_floating_point_v<T>)
+			{
+				// integral values are written without a fractional part.
+				switch (m_type)
+				{
+					case EJsonType::Integer:	return static_cast<T>(m_integer);
+					case EJsonType::Unsigned:	return static_cast<T>(m_unsigned);
+					default:					return static_cast<T>(m_float);
 				}
-				else
+			}
+			else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>)
+			{
+				return T(m_string->data(), m_string->size());
+			}
+			else
+			{
+				static_assert(std::is_void_v<T>, "unsupported json value type");
+			}
+		}
+
+		const std::pmr::vector<JsonObject>& getArray() const
+		{
+			static const std::pmr::vector<JsonObject> empty;
+			return m_type == EJsonType::Array ? *m_array : empty;
+		}
+
+		const std::pmr::vector<Member>& getMembers() const
+		{
+			static const std::pmr::vector<Member> empty;
+			return m_type == EJsonType::Object ? *m_members : empty;
+		}
+
+		const JsonObject& getAt(size_t index) const
+		{
+			assert(m_type == EJsonType::Object && index < m_members->size());
+			return (*m_members)[index].second;
+		}
+
+		JsonObject& operator[](std::string_view key) 
+		{
+			if (m_type != EJsonType::Object)
+			{
+				*this = JsonObject(EJsonType::Object);
+			}
+
+			if (JsonObject* value = findLast(key))
+			{
+				return *value;
+			}
+			return m_members->emplace_back(key, JsonObject()).second;
+		}
+
+		// appends a member without looking for an existing key, so that parsing wide objects stays linear.
+		// duplicate keys are resolved by the lookups instead.
+		void emplace(std::pmr::string&& key, JsonObject&& value)
+		{
+			if (m_type != EJsonType::Object)
+			{
+				*this = JsonObject(EJsonType::Object);
+			}
+			m_members->emplace_back(std::move(key), std::move(value));
+		}
+
+		// returns nullptr when the key isn't a member. Like the direct reader, the last duplicate key wins.
+		const JsonObject* find(std::string_view key) const
+		{
+			return const_cast<JsonObject*>(this)->findLast(key);
+		}
+
+		bool has(std::string_view key) const
+		{
+			return find(key) != nullptr;
+		}
+
+		// missing keys return a null value, nothing is allocated.
+		const JsonObject& operator[](std::string_view key) const
+		{
+			static const JsonObject null;
+			const JsonObject* value = find(key);
+			return value != nullptr ? *value : null;
+		}
+
+		size_t size() const
+		{
+			switch (m_type)
+			{
+				case EJsonType::Array:	return m_array->size();
+				case EJsonType::Object:	return m_members->size();
+				default:				return 0;
+			}
+		}
+
+		EJsonType getType() const { return m_type; }
+		bool isValid() const { return m_type != EJsonType::Null; }
+
+	private:
+		friend class JsonDocument;
+
+		JsonObject* findLast(std::string_view key)
+		{
+			if (m_type == EJsonType::Object)
+			{
+				for (auto it = m_members->rbegin(); it != m_members->rend(); it++)
 				{
-					// primitive
-					const std::string::const_iterator start = parser.it;
-					auto isEndOfValueCharacter = [](char c) { return c == ',' || c == '\n' || c == '\r' || c == '\t' || c == '}'; };
-					while (!isEndOfValueCharacter(parser.get()) && parser.it != text.end())
+					if (it->first == key)
 					{
-						parser.inc();
+						return &it->second;
+					}
+				}
+			}
+			return nullptr;
+		}
+
+		template<typename T, typename ...Args>
+		static T* create(std::pmr::memory_resource* resource, Args&& ...args)
+		{
+			void* memory = resource->allocate(sizeof(T), alignof(T));
+			return new (memory) T(std::forward<Args>(args)..., std::pmr::polymorphic_allocator<T>(resource));
+		}
+
+		template<typename T>
+		static void release(T* object)
+		{
+			std::pmr::memory_resource* resource = object->get_allocator().resource();
+			std::destroy_at(object);
+			resource->deallocate(object, sizeof(T), alignof(T));
+		}
+
+		void copyFrom(const JsonObject& other)
+		{
+			// copies don't depend on the source's memory resource lifetime.
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+			m_type = other.m_type;
+			switch (m_type)
+			{
+				case EJsonType::String:	m_string = create<std::pmr::string>(resource, *other.m_string); break;
+				case EJsonType::Array:	m_array = create<std::pmr::vector<JsonObject>>(resource, *other.m_array); break;
+				case EJsonType::Object:	m_members = create<std::pmr::vector<Member>>(resource, *other.m_members); break;
+				default:				m_unsigned = other.m_unsigned; break;
+			}
+		}
+
+		void moveFrom(JsonObject& other)
+		{
+			m_type = other.m_type;
+			m_unsigned = other.m_unsigned;
+			other.m_type = EJsonType::Null;
+		}
+
+		void destroy()
+		{
+			switch (m_type)
+			{
+				case EJsonType::String:	release(m_string); break;
+				case EJsonType::Array:	release(m_array); break;
+				case EJsonType::Object:	release(m_members); break;
+				default:				break;
+			}
+			m_type = EJsonType::Null;
+		}
+
+		// forgets the storage without walking it, only valid when it lives in an arena that is about to be reset.
+		void abandon()
+		{
+			m_type = EJsonType::Null;
+		}
+
+		union
+		{
+			long long m_integer;
+			unsigned long long m_unsigned = 0;
+			double m_float;
+			bool m_boolean;
+			std::pmr::string* m_string;
+			std::pmr::vector<JsonObject>* m_array;
+			std::pmr::vector<Member>* m_members;
+		};
+		EJsonType m_type = EJsonType::Null;
+	};
+
+	static_assert(sizeof(void*) != 8 || sizeof(JsonObject) == 16, "JsonObject should stay a compact node");
+
+	namespace from
+	{
+		// json parser
+		namespace _impl
+		{
+			// the parser only references the input, nothing is copied until a value is materialized.
+			struct JsonParser
+			{
+				const char* begin = nullptr;
+				const char* it = nullptr;
+				const char* end = nullptr;
+				std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+				// large arrays are split among this many threads by the direct reader.
+				uint32_t threadCount = 1;
+				// the direct reader overwrites the destination in place instead of expecting a new one,
+				// strings and containers keep their capacity and whatever the input doesn't set is reset.
+				bool isReusingRecords = false;
+				bool hasError = false;
+				// scratch buffer for keys with escapes, kept between reads.
+				std::string unescapedKey;
+
+				void inc() { it++; }
+
+				// lines and columns are only needed to report errors, they're computed from the offset on demand.
+				void getLocation(size_t& outLine, size_t& outColumn) const
+				{
+					outLine = 0;
+					outColumn = 0;
+					for (const char* c = begin; c != it; c++)
+					{
+						if (*c == '\n')
+						{
+							outColumn = 0;
+							outLine++;
+						}
+						else
+						{
+							outColumn++;
+						}
 					}
-					std::string value = text.substr(start - text.begin(), parser.it - start);
-					parser.it--; // we go back one step because that's the behavior expected of this function.
-					if (value == "true")
+				}
+
+				// returns '\0' past the end of the input so that callers don't need to check bounds before peeking.
+				char get() const { return it != end ? *it : '\0'; }
+				bool isAtEnd() const { return it == end; }
+			};
+
+			inline JsonObject parseMany(JsonParser& parser);
+			inline JsonObject parse(JsonParser& parser);
+			inline void skipWhitespaces(JsonParser& parser);
+			inline bool readString(JsonParser& parser, std::string_view& outValue, bool& outHasEscapes);
+			inline std::pmr::string toString(const JsonParser& parser, std::string_view value, bool hasEscapes);
+			inline bool readPrimitive(JsonParser& parser, std::string_view& outValue);
+			inline bool parsePrimitive(std::string_view value, JsonObject& outValue);
+			inline bool isNumber(std::string_view value);
+			inline void unescape(auto& out, std::string_view text);
+			inline void appendUtf8(auto& out, uint32_t codePoint);
+			inline JsonObject error(JsonParser& parser);
+			inline void reportError(const JsonParser& parser);
+
+			inline JsonObject parseMany(JsonParser& parser)
+			{
+				if (parser.get() != '{')
+				{
+					return error(parser);
+				}
+
+				parser.inc();
+				skipWhitespaces(parser);
+
+				JsonObject obj(EJsonType::Object, parser.resource);
+				while (parser.get() != '}')
+				{
+					std::string_view key;
+					bool hasEscapes = false;
+					if (!readString(parser, key, hasEscapes))
 					{
-						return JsonObject(true);
+						// we expect a key
+						return error(parser);
 					}
-					else if (value == "false")
+
+					skipWhitespaces(parser);
+					if (parser.get() != ':')
 					{
-						return JsonObject(false);
+						// we expect a : between keys and values
+						return error(parser);
 					}
-					else if (value.find(".") != std::string::npos)
+
+					parser.inc();
+					skipWhitespaces(parser);
+					
+					JsonObject value = parse(parser);
+					if (parser.hasError)
 					{
-						return JsonObject(std::stod(value));
+						return JsonObject();
 					}
-					else if (value.find("-") != std::string::npos)
+					obj.emplace(toString(parser, key, hasEscapes), std::move(value));
+
+					skipWhitespaces(parser);
+					if (parser.get() == ',')
 					{
-						return JsonObject(std::stol(value));
+						// a trailing comma before the closing brace is tolerated.
+						parser.inc();
+						skipWhitespaces(parser);
 					}
-					else
+					else if (parser.get() != '}')
 					{
-						return JsonObject(std::stoull(value));
+						return error(parser);
 					}
 				}
+
+				// skip }
+				parser.inc();
+				return obj;
 			}
 
-			inline void skipWhitespaces(JsonParser& parser, const std::string& text)
+			inline JsonObject parse(JsonParser& parser)
 			{
-				// skip white space
-				while (parser.get() == ' ' || parser.get() == '\n' || parser.get() == '\t' || parser.get() == '\r' && parser.it != text.end())
+				if (parser.get() == '{')
+				{
+					return parseMany(parser);
+				} 
+				else if (parser.get() == '[')
 				{
+					// array
 					parser.inc();
-				}
-			}
+					skipWhitespaces(parser);
 
-			inline JsonObject error(const JsonParser& parser)
-			{
-				std::cout << std::format("[ManiZ::json]: failed to parse, error at line {}:{}", parser.line, parser.column) << std::endl;
-				return JsonObject();
-			}
-		}
+					std::pmr::vector<JsonObject> vec(parser.resource);
+					while (parser.get() != ']')
+					{
+						if (parser.isAtEnd())
+						{
+							return error(parser);
+						}
 
-		// object builder
-		namespace _impl
-		{
-			inline void deserializeMany(size_t index, const JsonObject& json, const std::vector<std::string>& names, auto& first, auto& ...others);
-			inline void deserializeMany(size_t index, const JsonObject& json, const std::vector<std::string>& names);
-			inline void deserialize(size_t index, const JsonObject& json, const std::vector<std::string>& names, auto& data, bool isLeaf = false);
+						vec.push_back(parse(parser));
+						if (parser.hasError)
+						{
+							return JsonObject();
+						}
+
+						skipWhitespaces(parser);
+						if (parser.get() == ',')
+						{
+							parser.inc();
+							skipWhitespaces(parser);
+						}
+						else if (parser.get() != ']')
+						{
+							return error(parser);
+						}
+					}
 
-			inline void deserializeMany(size_t index, const JsonObject& json, const std::vector<std::string>& names) {}
+					// skip ]
+					parser.inc();
+					return JsonObject(std::move(vec));
+				}
+				else if (parser.get() == '"')
+				{
+					// string
+					std::string_view value;
+					bool hasEscapes = false;
+					if (!readString(parser, value, hasEscapes))
+					{
+						return error(parser);
+					}
+					return JsonObject(toString(parser, value, hasEscapes));
+				}
+				else
+				{
+					// primitive
+					std::string_view value;
+					JsonObject json;
+					if (!readPrimitive(parser, value) || !parsePrimitive(value, json))
+					{
+						return error(parser);
+					}
+					return json;
+				}
+			}
 
-			inline void deserializeMany(size_t index, const JsonObject& json, const std::vector<std::string>& names, auto& first, auto& ...others)
+			inline bool readPrimitive(JsonParser& parser, std::string_view& outValue)
 			{
-				deserialize(index, json, names, first);
-				deserializeMany(index + 1, json, names, others...);
+				const char* start = parser.it;
+				auto isEndOfValueCharacter = [](char c) { return c == ',' || c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '}' || c == ']'; };
+				while (!parser.isAtEnd() && !isEndOfValueCharacter(parser.get()))
+				{
+					parser.inc();
+				}
+
+				outValue = std::string_view(start, parser.it - start);
+				return !outValue.empty();
 			}
-			
-			inline void deserialize(size_t index, const JsonObject& json, const std::vector<std::string>& names, auto& data, bool isLeaf)
+
+			inline bool parsePrimitive(std::string_view value, JsonObject& outValue)
 			{
-				using type = std::remove_cvref_t<decltype(data)>;
-				if constexpr (std::is_pointer_v<type> || RFL::memberCount<type>() == 0)
+				if (value == "null")
 				{
-					return;
+					outValue = JsonObject();
+					return true;
 				}
-				else
+				else if (value == "true")
+				{
+					outValue = JsonObject(true);
+					return true;
+				}
+				else if (value == "false")
+				{
+					outValue = JsonObject(false);
+					return true;
+				}
+				else if (!isNumber(value))
+				{
+					return false;
+				}
+
+				// numbers are converted straight from the input, without locale nor allocation.
+				const char* first = value.data();
+				const char* last = value.data() + value.size();
+				if (value.find_first_of(".eE") == std::string_view::npos)
 				{
-					if (!isLeaf)
+					if (value[0] == '-')
 					{
-						if constexpr (!ManiZ::is_aggregate_struct<type>)
+						int64_t integer = 0;
+						const auto [ptr, ec] = std::from_chars(first, last, integer);
+						if (ec == std::errc() && ptr == last)
 						{
-							constexpr bool IS_LEAF = true;
-							const std::string name = names[index];
-							if (json.has(name))
-							{
-								deserialize(0, json[name], names, data, IS_LEAF);
-							}
-							return;
+							outValue = JsonObject(integer);
+							return true;
 						}
 					}
-
-					if constexpr (std::is_enum_v<type> || std::is_fundamental_v<type> || ManiZ::is_string<type>::value)
+					else
 					{
-						if (isLeaf)
+						uint64_t integer = 0;
+						const auto [ptr, ec] = std::from_chars(first, last, integer);
+						if (ec == std::errc() && ptr == last)
 						{
-							data = json.get<type>();
+							outValue = JsonObject(integer);
+							return true;
 						}
 					}
-					else if constexpr (std::ranges::range<type>)
-					{
-						using value_type = typename type::value_type;
+					// integers out of the 64 bits range are kept as floating points.
+				}
 
-						// hard iterate over the container
-						const std::vector<JsonObject>& jsonArray = json.getArray();
-						const size_t size = jsonArray.size();
+				double number = 0.0;
+				const auto [ptr, ec] = std::from_chars(first, last, number);
+				if (ec != std::errc() || ptr != last)
+				{
+					return false;
+				}
+				outValue = JsonObject(number);
+				return true;
+			}
 
-						if constexpr (requires { data.resize(size); })
-						{
-							data.resize(size);
-						}
+			inline bool isNumber(std::string_view value)
+			{
+				// from_chars also accepts inf and nan, json numbers always start with a digit.
+				const size_t digit = !value.empty() && value[0] == '-' ? 1 : 0;
+				return value.size() > digit && value[digit] >= '0' && value[digit] <= '9';
+			}
 
-						for (size_t index = 0; index < size; index++)
-						{
-							const JsonObject& jsonObject = jsonArray[index];
-							constexpr bool isLeaf = true;
-							deserialize(0, jsonObject, names, data[index], isLeaf);
-						}
+			inline void skipWhitespaces(JsonParser& parser)
+			{
+				// compact json rarely has whitespaces, the vectorized scan is only worth it for indented input.
+				if (SIMD::_impl::isWhitespace(parser.get()))
+				{
+					parser.it = SIMD::skipWhitespaces(parser.it, parser.end);
+				}
+			}
+
+			inline bool readString(JsonParser& parser, std::string_view& outValue, bool& outHasEscapes)
+			{
+				if (parser.get() != '"')
+				{
+					return false;
+				}
+
+				// skip "
+				parser.inc();
+
+				// moves to the closing quote, escaped quotes are part of the string.
+				const char* start = parser.it;
+				outHasEscapes = false;
+				while (true)
+				{
+					parser.it = SIMD::findQuoteOrBackslash(parser.it, parser.end);
+					if (parser.isAtEnd())
+					{
+						return false;
 					}
-					else
+					else if (parser.get() == '"')
 					{
-						if (isLeaf)
-						{
-							// we're in an aggregate type
-							RFL::visitMembers(data, [&](auto& ...members)
-							{
-								// we're in a nested structure
-								auto memberNames = RFL::getMemberNames<type>();
-								deserializeMany(0, json, memberNames, members...);
-							});
-						}
-						else
-						{
+						break;
+					}
 
-							const std::string name = names[index];
-							if (json.has(name))
-							{
-								RFL::visitMembers(data, [&](auto& ...members)
-								{
-									auto memberNames = RFL::getMemberNames<type>();
-									deserializeMany(0, json[name], memberNames, members...);
-								});
-							}
-						}
+					// skip the backslash and the escaped character.
+					outHasEscapes = true;
+					parser.inc();
+					if (parser.isAtEnd())
+					{
+						return false;
 					}
+					parser.inc();
 				}
+
+				outValue = std::string_view(start, parser.it - start);
+
+				// skip "
+				parser.inc();
+				return true;
 			}
-		}
 
-		inline JsonObject parse(const std::string& jsonString)
-		{
-			if (jsonString.empty())
+			inline std::pmr::string toString(const JsonParser& parser, std::string_view value, bool hasEscapes)
 			{
-				return JsonObject();
+				// strings are only copied once, when they're materialized.
+				if (!hasEscapes)
+				{
+					return std::pmr::string(value, parser.resource);
+				}
+				std::pmr::string out(parser.resource);
+				unescape(out, value);
+				return out;
 			}
-			_impl::JsonParser parser;
-			parser.it = jsonString.begin();
-			return _impl::parseMany(parser, jsonString);
-		}
 
+			inline void unescape(auto& out, std::string_view text)
+			{
+				out.reserve(out.size() + text.size());
+
+				const auto readHex = [&](size_t position) -> uint32_t
+				{
+					uint32_t value = 0;
+					for (size_t i = position; i < position + 4 && i < text.size(); i++)
+					{
+						const char c = text[i];
+						value <<= 4;
+						if (c >= '0' && c <= '9')		value |= c - '0';
+						else if (c >= 'a' && c <= 'f')	value |= c - 'a' + 10;
+						else if (c >= 'A' && c <= 'F')	value |= c - 'A' + 10;
+					}
+					return value;
+				};
+
+				for (size_t i = 0; i < text.size(); i++)
+				{
+					if (text[i] != '\\' || i + 1 == text.size())
+					{
+						out.push_back(text[i]);
+						continue;
+					}
+
+					i++;
+					switch (text[i])
+					{
+						case 'n': out.push_back('\n'); break;
+						case 'r': out.push_back('\r'); break;
+						case 't': out.push_back('\t'); break;
+						case 'b': out.push_back('\b'); break;
+						case 'f': out.push_back('\f'); break;
+						case 'u':
+						{
+							uint32_t codePoint = readHex(i + 1);
+							i += 4;
+							// utf-16 surrogate pairs are combined into a single code point.
+							if (codePoint >= 0xD800 && codePoint < 0xDC00 && i + 6 < text.size() && text[i + 1] == '\\' && text[i + 2] == 'u')
+							{
+								const uint32_t low = readHex(i + 3);
+								codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+								i += 6;
+							}
+							appendUtf8(out, codePoint);
+							break;
+						}
+						default: out.push_back(text[i]); break;
+					}
+				}
+			}
+
+			inline void appendUtf8(auto& out, uint32_t codePoint)
+			{
+				if (codePoint < 0x80)
+				{
+					out.push_back(static_cast<char>(codePoint));
+				}
+				else if (codePoint < 0x800)
+				{
+					out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+					out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+				}
+				else if (codePoint < 0x10000)
+				{
+					out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+					out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+					out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+				}
+				else
+				{
+					out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+					out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+					out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+					out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+				}
+			}
+
+			inline JsonObject error(JsonParser& parser)
+			{
+				// errors bubble up through every nesting level, they're only reported once.
+				if (!parser.hasError)
+				{
+					parser.hasError = true;
+					reportError(parser);
+				}
+				return JsonObject();
+			}
+
+			inline void reportError(const JsonParser& parser)
+			{
+				size_t line = 0;
+				size_t column = 0;
+				parser.getLocation(line, column);
+				std::cout << std::format("[ManiZ::json]: failed to parse, error at line {}:{}", line, column) << std::endl;
+			}
+		}
+
+		// two stage parsing for large documents, similar to simdjson:
+		// stage 1 indexes every structural character, quote and primitive start with vector instructions,
+		// stage 2 builds the document by walking that index instead of branching on every byte.
+		namespace _impl
+		{
+			struct IndexedJsonParser
+			{
+				// holds the input bounds, the memory resource and the error state.
+				JsonParser parser;
+				const uint32_t* it = nullptr;
+				const uint32_t* end = nullptr;
+
+				char get() const { return it != end ? parser.begin[*it] : '\0'; }
+				const char* position() const { return it != end ? parser.begin + *it : parser.end; }
+			};
+
+			inline bool buildStructuralIndex(std::string_view text, std::vector<uint32_t>& outIndex);
+			inline bool classifyBlocks(std::string_view text, auto&& onBlock);
+			inline uint64_t findEscaped(uint64_t backslash, uint64_t& prevEscaped);
+			inline JsonObject parseIndexed(IndexedJsonParser& parser);
+			inline JsonObject error(IndexedJsonParser& parser);
+
+			inline bool buildStructuralIndex(std::string_view text, std::vector<uint32_t>& outIndex)
+			{
+				outIndex.clear();
+				return classifyBlocks(text, [&](size_t offset, uint64_t structurals, uint64_t quotes, uint64_t primitiveStarts)
+				{
+					uint64_t bits = structurals | quotes | primitiveStarts;
+					while (bits != 0)
+					{
+						outIndex.push_back(static_cast<uint32_t>(offset + std::countr_zero(bits)));
+						bits &= bits - 1;
+					}
+					return true;
+				});
+			}
+
+			// calls onBlock(offset, structurals, quotes, primitiveStarts) with the masks of each 64 bytes block, until it returns false.
+			// returns false when the text ends inside a string.
+			inline bool classifyBlocks(std::string_view text, auto&& onBlock)
+			{
+				// carried from one 64 bytes block to the next.
+				uint64_t prevEscaped = 0;
+				uint64_t prevInString = 0;
+				uint64_t prevIsPrimitive = 0;
+
+				char padded[64];
+				for (size_t offset = 0; offset < text.size(); offset += 64)
+				{
+					const char* block = text.data() + offset;
+					if (text.size() - offset < 64)
+					{
+						// the last block is padded with whitespaces, which are never indexed.
+						std::memset(padded, ' ', sizeof(padded));
+						std::memcpy(padded, block, text.size() - offset);
+						block = padded;
+					}
+
+					SIMD::BlockMasks masks;
+					SIMD::classifyBlock(block, masks);
+
+					const uint64_t quotes = masks.quote & ~findEscaped(masks.backslash, prevEscaped);
+
+					// set from an opening quote up to its closing quote, excluded.
+					const uint64_t inString = SIMD::prefixXor(quotes) ^ prevInString;
+					prevInString = 0 - (inString >> 63);
+
+					const uint64_t structurals = masks.structural & ~inString;
+					const uint64_t primitives = ~(masks.whitespace | masks.structural | quotes | inString);
+					const uint64_t primitiveStarts = primitives & ~((primitives << 1) | prevIsPrimitive);
+					prevIsPrimitive = primitives >> 63;
+
+					if (!onBlock(offset, structurals, quotes, primitiveStarts))
+					{
+						return true;
+					}
+				}
+
+				// a string that is still open at the end of the input is an error.
+				return prevInString == 0;
+			}
+
+			inline uint64_t findEscaped(uint64_t backslash, uint64_t& prevEscaped)
+			{
+				// a character is escaped when it follows a run of backslashes of odd length.
+				constexpr uint64_t evenBits = 0x5555555555555555ull;
+
+				backslash &= ~prevEscaped;
+				const uint64_t followsEscape = (backslash << 1) | prevEscaped;
+				const uint64_t oddSequenceStarts = backslash & ~evenBits & ~followsEscape;
+
+				const uint64_t sequencesStartingOnEvenBits = oddSequenceStarts + backslash;
+				// the carry of the addition tells whether the last run continues in the next block.
+				prevEscaped = sequencesStartingOnEvenBits < oddSequenceStarts ? 1 : 0;
+
+				const uint64_t invertMask = sequencesStartingOnEvenBits << 1;
+				return (evenBits ^ invertMask) & followsEscape;
+			}
+
+			inline JsonObject parseIndexed(IndexedJsonParser& parser)
+			{
+				const char c = parser.get();
+				if (c == '{')
+				{
+					parser.it++;
+					JsonObject obj(EJsonType::Object, parser.parser.resource);
+					while (parser.get() != '}')
+					{
+						// a key is an opening quote followed by its closing quote.
+						if (parser.get() != '"' || parser.end - parser.it < 2)
+						{
+							return error(parser);
+						}
+
+						const char* keyStart = parser.position() + 1;
+						parser.it++;
+						const char* keyEnd = parser.position();
+						parser.it++;
+						const bool hasEscapes = SIMD::findQuoteOrBackslash(keyStart, keyEnd) != keyEnd;
+
+						if (parser.get() != ':')
+						{
+							return error(parser);
+						}
+						parser.it++;
+
+						JsonObject value = parseIndexed(parser);
+						if (parser.parser.hasError)
+						{
+							return JsonObject();
+						}
+						obj.emplace(toString(parser.parser, std::string_view(keyStart, keyEnd - keyStart), hasEscapes), std::move(value));
+
+						if (parser.get() == ',')
+						{
+							parser.it++;
+						}
+						else if (parser.get() != '}')
+						{
+							return error(parser);
+						}
+					}
+
+					// skip }
+					parser.it++;
+					return obj;
+				}
+				else if (c == '[')
+				{
+					parser.it++;
+					std::pmr::vector<JsonObject> vec(parser.parser.resource);
+					while (parser.get() != ']')
+					{
+						if (parser.it == parser.end)
+						{
+							return error(parser);
+						}
+
+						vec.push_back(parseIndexed(parser));
+						if (parser.parser.hasError)
+						{
+							return JsonObject();
+						}
+
+						if (parser.get() == ',')
+						{
+							parser.it++;
+						}
+						else if (parser.get() != ']')
+						{
+							return error(parser);
+						}
+					}
+
+					// skip ]
+					parser.it++;
+					return JsonObject(std::move(vec));
+				}
+				else if (c == '"')
+				{
+					if (parser.end - parser.it < 2)
+					{
+						return error(parser);
+					}
+
+					const char* start = parser.position() + 1;
+					parser.it++;
+					const char* end = parser.position();
+					parser.it++;
+					const bool hasEscapes = SIMD::findQuoteOrBackslash(start, end) != end;
+					return JsonObject(toString(parser.parser, std::string_view(start, end - start), hasEscapes));
+				}
+				else if (c == '\0' || c == '}' || c == ']' || c == ':' || c == ',')
+				{
+					return error(parser);
+				}
+				else
+				{
+					// a primitive runs until the next indexed character, minus the whitespaces.
+					const char* start = parser.position();
+					parser.it++;
+					const char* end = parser.position();
+					while (end != start && SIMD::_impl::isWhitespace(end[-1]))
+					{
+						end--;
+					}
+
+					JsonObject json;
+					if (!parsePrimitive(std::string_view(start, end - start), json))
+					{
+						parser.it--;
+						return error(parser);
+					}
+					return json;
+				}
+			}
+
+			inline JsonObject error(IndexedJsonParser& parser)
+			{
+				parser.parser.it = parser.position();
+				return error(parser.parser);
+			}
+
+			inline JsonObject parseIndexed(std::string_view jsonString, std::pmr::memory_resource* resource, std::vector<uint32_t>& index)
+			{
+				IndexedJsonParser parser;
+				parser.parser.begin = jsonString.data();
+				parser.parser.it = jsonString.data();
+				parser.parser.end = jsonString.data() + jsonString.size();
+				parser.parser.resource = resource;
+
+				if (!buildStructuralIndex(jsonString, index))
+				{
+					parser.parser.it = parser.parser.end;
+					return error(parser.parser);
+				}
+
+				if (index.empty())
+				{
+					return JsonObject();
+				}
+
+				parser.it = index.data();
+				parser.end = index.data() + index.size();
+				JsonObject json = parseIndexed(parser);
+				if (!parser.parser.hasError && parser.it != parser.end)
+				{
+					// there is something after the document.
+					error(parser);
+				}
+				return parser.parser.hasError ? JsonObject() : std::move(json);
+			}
+		}
+
+		// direct deserialization, the tokens are read straight into the destination without building a JsonObject tree.
+		namespace _impl
+		{
+			inline bool read(JsonParser& parser, auto& data);
+			template<typename T>
+			inline bool readMembers(JsonParser& parser, T& data);
+			template<typename T, size_t I>
+			inline bool readMember(JsonParser& parser, T& data);
+			inline bool readArray(JsonParser& parser, auto& data);
+			inline bool readArrayParallel(JsonParser& parser, auto& data);
+			inline bool findElementSeparators(JsonParser& parser, std::vector<const char*>& outSeparators, const char*& outClosing);
+			inline bool skipValue(JsonParser& parser);
+			inline bool readElement(JsonParser& parser, auto& data);
+			template<typename T, size_t N>
+			inline void resetMissingMembers(T& data, const std::bitset<N>& isRead);
+			inline void assignValue(auto& data, const auto& value);
+
+			inline constexpr uint64_t hashKey(std::string_view key)
+			{
+				// fnv-1a
+				uint64_t hash = 14695981039346656037ull;
+				for (const char c : key)
+				{
+					hash ^= static_cast<uint8_t>(c);
+					hash *= 1099511628211ull;
+				}
+				return hash;
+			}
+
+			inline constexpr uint64_t mixKey(uint64_t hash, uint32_t seed)
+			{
+				// rehashes the key's hash with a bucket's seed without reading the key again.
+				hash ^= seed * 0x9E3779B97F4A7C15ull;
+				hash ^= hash >> 33;
+				hash *= 0xFF51AFD7ED558CCDull;
+				hash ^= hash >> 33;
+				return hash;
+			}
+
+			// perfect hash from a member name to its index, built at compile time with the hash and displace method:
+			// keys are first split in buckets, then each bucket gets a seed that sends its keys to free slots.
+			template<size_t Count>
+			struct MemberKeyTable
+			{
+				static constexpr size_t bucketCount = std::bit_ceil(std::max<size_t>(Count / 2, 1));
+				static constexpr size_t slotCount = std::bit_ceil(std::max<size_t>(Count, 1)) * 2;
+				static constexpr uint8_t emptySlot = 0xFF;
+				static_assert(Count < emptySlot, "too many members for the key table");
+
+				std::array<uint32_t, bucketCount> seeds{};
+				std::array<uint8_t, slotCount> slots{};
+
+				constexpr size_t find(uint64_t hash) const
+				{
+					const uint32_t seed = seeds[hash & (bucketCount - 1)];
+					return slots[mixKey(hash, seed) & (slotCount - 1)];
+				}
+			};
+
+			template<typename T>
+			inline consteval auto makeMemberKeyTable()
+			{
+				constexpr auto& names = RFL::getMemberNameTable<T>();
+				using Table = MemberKeyTable<names.size()>;
+
+				Table table;
+				table.slots.fill(Table::emptySlot);
+
+				std::array<uint64_t, names.size()> hashes{};
+				std::array<std::array<uint8_t, names.size()>, Table::bucketCount> buckets{};
+				std::array<size_t, Table::bucketCount> bucketSizes{};
+				for (size_t i = 0; i < names.size(); i++)
+				{
+					hashes[i] = hashKey(names[i]);
+					const size_t bucket = hashes[i] & (Table::bucketCount - 1);
+					buckets[bucket][bucketSizes[bucket]++] = static_cast<uint8_t>(i);
+				}
+
+				// the largest buckets are placed first, while most slots are still free.
+				std::array<size_t, Table::bucketCount> order{};
+				for (size_t i = 0; i < order.size(); i++)
+				{
+					order[i] = i;
+				}
+				std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return bucketSizes[a] > bucketSizes[b]; });
+
+				for (const size_t bucket : order)
+				{
+					for (uint32_t seed = 0; ; seed++)
+					{
+						std::array<size_t, names.size()> candidates{};
+						bool isValid = true;
+						for (size_t i = 0; i < bucketSizes[bucket] && isValid; i++)
+						{
+							candidates[i] = mixKey(hashes[buckets[bucket][i]], seed) & (Table::slotCount - 1);
+							isValid = table.slots[candidates[i]] == Table::emptySlot;
+							for (size_t j = 0; j < i && isValid; j++)
+							{
+								isValid = candidates[i] != candidates[j];
+							}
+						}
+
+						if (isValid)
+						{
+							table.seeds[bucket] = seed;
+							for (size_t i = 0; i < bucketSizes[bucket]; i++)
+							{
+								table.slots[candidates[i]] = buckets[bucket][i];
+							}
+							break;
+						}
+					}
+				}
+				return table;
+			}
+
+			template<typename T>
+			inline constexpr auto memberKeyTable = makeMemberKeyTable<T>();
+
+			template<typename T, size_t ...I>
+			inline constexpr auto makeMemberReaders(std::index_sequence<I...>)
+			{
+				return std::array<bool(*)(JsonParser&, T&), sizeof...(I)>{ &readMember<T, I>... };
+			}
+
+			// one reader per member, indexed like the member name table.
+			template<typename T>
+			inline constexpr auto memberReaders = makeMemberReaders<T>(std::make_index_sequence<RFL::memberCount<T>()>());
+
+			inline bool read(JsonParser& parser, auto& data)
+			{
+				using type = std::remove_cvref_t<decltype(data)>;
+				if (parser.get() == 'n')
+				{
+					// null values leave the destination untouched.
+					std::string_view value;
+					return readPrimitive(parser, value) && value == "null";
+				}
+
+				if constexpr (std::is_pointer_v<type> || RFL::memberCount<type>() == 0)
+				{
+					return skipValue(parser);
+				}
+				else if constexpr (ManiZ::is_string<type>::value)
+				{
+					std::string_view value;
+					bool hasEscapes = false;
+					if (!readString(parser, value, hasEscapes))
+					{
+						return false;
+					}
+
+					// the existing capacity of the destination is reused.
+					data.clear();
+					if (hasEscapes)
+					{
+						unescape(data, value);
+					}
+					else
+					{
+						data.assign(value);
+					}
+					return true;
+				}
+				else if constexpr (std::is_enum_v<type> || std::is_fundamental_v<type>)
+				{
+					std::string_view value;
+					if (parser.get() == '"' || !readPrimitive(parser, value))
+					{
+						return false;
+					}
+
+					if constexpr (std::is_arithmetic_v<type> && !std::is_same_v<type, bool>)
+					{
+						// the common case, the number is converted directly to the destination type.
+						const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), data);
+						if (ec == std::errc() && ptr == value.data() + value.size() && isNumber(value))
+						{
+							return true;
+						}
+
+						// integers that don't fit the destination are an error, they would be silently truncated.
+						if constexpr (std::is_integral_v<type>)
+						{
+							if (ec == std::errc::result_out_of_range || (std::is_unsigned_v<type> && value.starts_with('-')))
+							{
+								return false;
+							}
+						}
+					}
+
+					// a boolean where a number is expected, or the other way around, is an error.
+					// whole numbers written as 1.0 or 1e2 are still read into integers, is<type> checks their range.
+					JsonObject json;
+					if (!parsePrimitive(value, json) || !json.is<type>())
+					{
+						return false;
+					}
+					data = json.get<type>();
+					return true;
+				}
+				else if constexpr (std::ranges::range<type>)
+				{
+					return readArray(parser, data);
+				}
+				else
+				{
+					return readMembers(parser, data);
+				}
+			}
+
+			template<typename T>
+			inline bool readMembers(JsonParser& parser, T& data)
+			{
+				if (parser.get() != '{')
+				{
+					return false;
+				}
+
+				parser.inc();
+				skipWhitespaces(parser);
+
+				constexpr auto& names = RFL::getMemberNameTable<T>();
+				constexpr auto& keyTable = memberKeyTable<T>;
+				std::bitset<names.size()> isRead;
+				while (parser.get() != '}')
+				{
+					std::string_view key;
+					bool hasEscapes = false;
+					if (!readString(parser, key, hasEscapes))
+					{
+						return false;
+					}
+
+					// the key isn't needed anymore once its member is found, nested objects can reuse the buffer.
+					if (hasEscapes)
+					{
+						parser.unescapedKey.clear();
+						unescape(parser.unescapedKey, key);
+						key = parser.unescapedKey;
+					}
+
+					skipWhitespaces(parser);
+					if (parser.get() != ':')
+					{
+						return false;
+					}
+
+					parser.inc();
+					skipWhitespaces(parser);
+
+					// the hash gives the only member that can match, a single compare confirms it.
+					const size_t index = keyTable.find(hashKey(key));
+					const bool isKnown = index < names.size() && names[index] == key;
+					// null members are reset like missing ones.
+					if (isKnown && parser.get() != 'n')
+					{
+						isRead.set(index);
+					}
+
+					// unknown keys are skipped without being materialized.
+					const bool isValid = isKnown ? memberReaders<T>[index](parser, data) : skipValue(parser);
+					if (!isValid)
+					{
+						return false;
+					}
+
+					skipWhitespaces(parser);
+					if (parser.get() == ',')
+					{
+						parser.inc();
+						skipWhitespaces(parser);
+					}
+					else if (parser.get() != '}')
+					{
+						return false;
+					}
+				}
+
+				// skip }
+				parser.inc();
+				if (parser.isReusingRecords)
+				{
+					resetMissingMembers(data, isRead);
+				}
+				return true;
+			}
+
+			template<typename T, size_t I>
+			inline bool readMember(JsonParser& parser, T& data)
+			{
+				return RFL::visitMembers(data, [&](auto& ...members)
+				{
+					return read(parser, std::get<I>(std::tie(members...)));
+				});
+			}
+
+			inline bool readArray(JsonParser& parser, auto& data)
+			{
+				if (parser.get() != '[')
+				{
+					return false;
+				}
+
+				using type = std::remove_cvref_t<decltype(data)>;
+				if constexpr (std::ranges::random_access_range<type> && requires { data.resize(size_t()); } && !std::is_same_v<std::ranges::range_value_t<type>, bool>)
+				{
+					if (parser.threadCount > 1)
+					{
+						return readArrayParallel(parser, data);
+					}
+				}
+
+				parser.inc();
+				skipWhitespaces(parser);
+
+				// reused records overwrite their elements, so that the strings and containers inside them keep their capacity.
+				constexpr bool canReuseElements = std::ranges::random_access_range<type> && requires { data.resize(size_t()); data.emplace_back(); }
+					&& !std::is_same_v<std::ranges::range_value_t<type>, bool>;
+				if constexpr (requires { data.clear(); })
+				{
+					if (!canReuseElements || !parser.isReusingRecords)
+					{
+						data.clear();
+					}
+				}
+
+				size_t index = 0;
+				while (parser.get() != ']')
+				{
+					if (parser.isAtEnd())
+					{
+						return false;
+					}
+
+					bool isValid = false;
+					if constexpr (canReuseElements)
+					{
+						isValid = index < std::size(data) ? readElement(parser, data[index]) : read(parser, data.emplace_back());
+					}
+					else if constexpr (requires { data.emplace_back(); })
+					{
+						isValid = read(parser, data.emplace_back());
+					}
+					else if (index < std::size(data))
+					{
+						// fixed size containers keep their size, extra elements are ignored.
+						isValid = readElement(parser, data[index]);
+					}
+					else
+					{
+						isValid = skipValue(parser);
+					}
+
+					if (!isValid)
+					{
+						return false;
+					}
+					index++;
+
+					skipWhitespaces(parser);
+					if (parser.get() == ',')
+					{
+						parser.inc();
+						skipWhitespaces(parser);
+					}
+					else if (parser.get() != ']')
+					{
+						return false;
+					}
+				}
+
+				// skip ]
+				parser.inc();
+				if constexpr (canReuseElements)
+				{
+					if (parser.isReusingRecords)
+					{
+						data.resize(index);
+					}
+				}
+				else if constexpr (!requires { data.emplace_back(); })
+				{
+					if (parser.isReusingRecords)
+					{
+						// the elements the input doesn't have go back to their default value.
+						for (; index < std::size(data); index++)
+						{
+							assignValue(data[index], std::ranges::range_value_t<type>{});
+						}
+					}
+				}
+				return true;
+			}
+
+			inline bool readElement(JsonParser& parser, auto& data)
+			{
+				// null leaves the destination untouched, a reused element has to be reset like a new one would be.
+				if (parser.isReusingRecords && parser.get() == 'n')
+				{
+					assignValue(data, std::remove_cvref_t<decltype(data)>{});
+				}
+				return read(parser, data);
+			}
+
+			template<typename T, size_t N>
+			inline void resetMissingMembers(T& data, const std::bitset<N>& isRead)
+			{
+				if (isRead.all())
+				{
+					return;
+				}
+
+				// members are reset from a default constructed T, so that their initializers are honored.
+				static const T defaults = T();
+				RFL::visitMembers(data, [&](auto& ...members)
+				{
+					RFL::visitMembers(defaults, [&](const auto& ...defaultMembers)
+					{
+						size_t index = 0;
+						((isRead[index++] ? void() : assignValue(members, defaultMembers)), ...);
+					});
+				});
+			}
+
+			inline void assignValue(auto& data, const auto& value)
+			{
+				using type = std::remove_cvref_t<decltype(data)>;
+				if constexpr (std::is_array_v<type>)
+				{
+					for (size_t i = 0; i < std::size(data); i++)
+					{
+						assignValue(data[i], value[i]);
+					}
+				}
+				else if constexpr (std::is_copy_assignable_v<type>)
+				{
+					// copying keeps the capacity of the destination, moving a default value would release it.
+					data = value;
+				}
+				else if constexpr (std::is_move_assignable_v<type> && std::is_default_constructible_v<type>)
+				{
+					data = type();
+				}
+			}
+
+			inline bool readArrayParallel(JsonParser& parser, auto& data)
+			{
+				// below this, starting threads costs more than reading the elements.
+				constexpr size_t minElementsPerThread = 256;
+
+				std::vector<const char*> separators;
+				const char* closing = nullptr;
+				if (!findElementSeparators(parser, separators, closing))
+				{
+					return false;
+				}
+
+				// like readArray, a trailing comma is tolerated, it doesn't start another element.
+				if (!separators.empty() && SIMD::skipWhitespaces(separators.back() + 1, closing) == closing)
+				{
+					separators.pop_back();
+				}
+
+				const char* first = SIMD::skipWhitespaces(parser.it + 1, closing);
+				const size_t count = first == closing ? 0 : separators.size() + 1;
+				data.clear();
+				data.resize(count);
+
+				const size_t chunkCount = std::clamp<size_t>(count / minElementsPerThread, 1, parser.threadCount);
+				std::vector<const char*> errors(chunkCount, nullptr);
+				const auto readChunk = [&](size_t chunk)
+				{
+					const size_t begin = chunk * count / chunkCount;
+					const size_t end = (chunk + 1) * count / chunkCount;
+
+					// every thread reads its own span of elements, nested arrays are read on the same thread.
+					JsonParser chunkParser;
+					chunkParser.begin = parser.begin;
+					chunkParser.it = begin == 0 ? parser.it + 1 : separators[begin - 1] + 1;
+					chunkParser.end = end == count ? closing : separators[end - 1];
+					chunkParser.resource = parser.resource;
+
+					for (size_t i = begin; i < end; i++)
+					{
+						skipWhitespaces(chunkParser);
+						if (!read(chunkParser, data[i]))
+						{
+							errors[chunk] = chunkParser.it;
+							return;
+						}
+
+						skipWhitespaces(chunkParser);
+						if (i + 1 != end && chunkParser.get() == ',')
+						{
+							chunkParser.inc();
+						}
+						else if (!chunkParser.isAtEnd())
+						{
+							errors[chunk] = chunkParser.it;
+							return;
+						}
+					}
+				};
+
+				std::vector<std::thread> threads;
+				threads.reserve(chunkCount - 1);
+				for (size_t chunk = 1; chunk < chunkCount; chunk++)
+				{
+					threads.emplace_back(readChunk, chunk);
+				}
+				readChunk(0);
+				for (std::thread& thread : threads)
+				{
+					thread.join();
+				}
+
+				for (const char* error : errors)
+				{
+					if (error != nullptr)
+					{
+						parser.it = error;
+						return false;
+					}
+				}
+
+				// skip ]
+				parser.it = closing + 1;
+				return true;
+			}
+
+			inline bool findElementSeparators(JsonParser& parser, std::vector<const char*>& outSeparators, const char*& outClosing)
+			{
+				// only the structural characters outside of strings are looked at, the values in between are skipped 64 bytes at a time.
+				const std::string_view text(parser.it, parser.end - parser.it);
+				size_t depth = 0;
+				outClosing = nullptr;
+				outSeparators.clear();
+				classifyBlocks(text, [&](size_t offset, uint64_t structurals, uint64_t, uint64_t)
+				{
+					while (structurals != 0)
+					{
+						const char* c = text.data() + offset + std::countr_zero(structurals);
+						structurals &= structurals - 1;
+						if (*c == '[' || *c == '{')
+						{
+							depth++;
+						}
+						else if (*c == ']' || *c == '}')
+						{
+							if (--depth == 0)
+							{
+								outClosing = c;
+								return false;
+							}
+						}
+						else if (*c == ',' && depth == 1)
+						{
+							outSeparators.push_back(c);
+						}
+					}
+					return true;
+				});
+
+				if (outClosing == nullptr || *outClosing != ']')
+				{
+					parser.it = parser.end;
+					return false;
+				}
+				return true;
+			}
+
+			inline bool skipValue(JsonParser& parser)
+			{
+				std::string_view value;
+				bool hasEscapes = false;
+				if (parser.get() == '"')
+				{
+					return readString(parser, value, hasEscapes);
+				}
+				else if (parser.get() != '{' && parser.get() != '[')
+				{
+					return readPrimitive(parser, value);
+				}
+
+				// containers are skipped by tracking their depth, strings are read whole as they can contain brackets.
+				size_t depth = 0;
+				do
+				{
+					if (parser.isAtEnd())
+					{
+						return false;
+					}
+
+					const char c = parser.get();
+					if (c == '"')
+					{
+						if (!readString(parser, value, hasEscapes))
+						{
+							return false;
+						}
+						continue;
+					}
+					else if (c == '{' || c == '[')
+					{
+						depth++;
+					}
+					else if (c == '}' || c == ']')
+					{
+						depth--;
+					}
+					parser.inc();
+				} while (depth > 0);
+				return true;
+			}
+		}
+
+		// object builder
+		namespace _impl
+		{
+			template<typename T>
+			inline void deserializeMembers(const JsonObject& json, T& data);
+			template<typename T, size_t I>
+			inline void deserializeMember(const JsonObject& json, T& data);
+			inline void deserialize(const JsonObject& json, auto& data);
+
+			template<typename T, size_t ...I>
+			inline constexpr auto makeMemberDeserializers(std::index_sequence<I...>)
+			{
+				return std::array<void(*)(const JsonObject&, T&), sizeof...(I)>{ &deserializeMember<T, I>... };
+			}
+
+			template<typename T>
+			inline constexpr auto memberDeserializers = makeMemberDeserializers<T>(std::make_index_sequence<RFL::memberCount<T>()>());
+
+			template<typename T>
+			inline void deserializeMembers(const JsonObject& json, T& data)
+			{
+				// the json members are walked once, each key finds its member with the same perfect hash as the direct reader.
+				// members that are missing from the json keep their current value, duplicate keys are applied in order so the last one wins.
+				constexpr auto& names = RFL::getMemberNameTable<T>();
+				constexpr auto& keyTable = memberKeyTable<T>;
+				for (const JsonObject::Member& member : json.getMembers())
+				{
+					const size_t index = keyTable.find(hashKey(member.first));
+					if (index < names.size() && names[index] == member.first)
+					{
+						memberDeserializers<T>[index](member.second, data);
+					}
+				}
+			}
+
+			template<typename T, size_t I>
+			inline void deserializeMember(const JsonObject& json, T& data)
+			{
+				RFL::visitMembers(data, [&](auto& ...members)
+				{
+					deserialize(json, std::get<I>(std::tie(members...)));
+				});
+			}
+
+			inline void deserialize(const JsonObject& json, auto& data)
+			{
+				using type = std::remove_cvref_t<decltype(data)>;
+				if constexpr (std::is_pointer_v<type> || RFL::memberCount<type>() == 0)
+				{
+					return;
+				}
+				else if (!json.isValid())
+				{
+					// null values leave the destination untouched.
+					return;
+				}
+				else if constexpr (std::is_enum_v<type> || std::is_fundamental_v<type> || ManiZ::is_string<type>::value)
+				{
+					// values of another type are skipped like missing ones, the document can come from anywhere.
+					if (json.is<type>())
+					{
+						data = json.get<type>();
+					}
+				}
+				else if constexpr (std::ranges::range<type>)
+				{
+					if (json.getType() != EJsonType::Array)
+					{
+						return;
+					}
+
+					// hard iterate over the container
+					const auto& jsonArray = json.getArray();
+					const size_t size = jsonArray.size();
+
+					if constexpr (requires { data.resize(size); })
+					{
+						data.resize(size);
+					}
+
+					for (size_t index = 0; index < size; index++)
+					{
+						deserialize(jsonArray[index], data[index]);
+					}
+				}
+				else if (json.getType() == EJsonType::Object)
+				{
+					// we're in an aggregate type
+					deserializeMembers(json, data);
+				}
+			}
+		}
+
+		// the input is only referenced during the parse, it can be a network buffer or a mapped file.
+		// every node and string is allocated from resource, which must outlive the returned object.
+		inline JsonObject parse(std::string_view jsonString, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+		{
+			_impl::JsonParser parser;
+			parser.begin = jsonString.data();
+			parser.it = jsonString.data();
+			parser.end = jsonString.data() + jsonString.size();
+			parser.resource = resource;
+
+			_impl::skipWhitespaces(parser);
+			if (parser.isAtEnd())
+			{
+				return JsonObject();
+			}
+
+			JsonObject json = _impl::parse(parser);
+			return parser.hasError ? JsonObject() : std::move(json);
+		}
+
+		inline JsonObject parse(const char* data, size_t size, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+		{
+			return parse(std::string_view(data, size), resource);
+		}
+
+		// builds the same document as parse, in two stages: it's faster on large inputs, but it needs
+		// 4 bytes of index per token. Inputs larger than 4GB fall back to parse.
+		inline JsonObject parseIndexed(std::string_view jsonString, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+		{
+			if (jsonString.size() > std::numeric_limits<uint32_t>::max())
+			{
+				return parse(jsonString, resource);
+			}
+
+			std::vector<uint32_t> index;
+			index.reserve(jsonString.size() / 4);
+			return _impl::parseIndexed(jsonString, resource, index);
+		}
+
+		// reads the json straight into a T, no intermediate JsonObject is built.
+		template<class T>
+		inline T json(std::string_view jsonString)
+		{
+			T obj;
+			_impl::JsonParser parser;
+			parser.begin = jsonString.data();
+			parser.it = jsonString.data();
+			parser.end = jsonString.data() + jsonString.size();
+
+			_impl::skipWhitespaces(parser);
+			if (!parser.isAtEnd() && !_impl::read(parser, obj))
+			{
+				_impl::reportError(parser);
+			}
+			return obj;
+		}
+
+		// same as json, but large arrays are read by several threads.
+		template<class T>
+		inline T jsonParallel(std::string_view jsonString, uint32_t threadCount = std::thread::hardware_concurrency())
+		{
+			T obj;
+			_impl::JsonParser parser;
+			parser.begin = jsonString.data();
+			parser.it = jsonString.data();
+			parser.end = jsonString.data() + jsonString.size();
+			parser.threadCount = std::max(threadCount, 1u);
+
+			_impl::skipWhitespaces(parser);
+			if (!parser.isAtEnd() && !_impl::read(parser, obj))
+			{
+				_impl::reportError(parser);
+			}
+			return obj;
+		}
+
+		// builds a T from an already parsed json document.
+		template<class T>
+		inline T json(const JsonObject& json)
+		{
+			T obj;
+			_impl::deserialize(json, obj);
+			return obj;
+		}
+
+		template<class T>
+		inline T json(const char* data, size_t size)
+		{
+			return json<T>(std::string_view(data, size));
+		}
+	}
+
+	// owns every node and string of a parsed document in a few large blocks.
+	// releasing a document is O(1), and the blocks are reused by the next parse instead of going back to the system.
+	class JsonDocument
+	{
+	public:
+		explicit JsonDocument(size_t blockSize = 64 * 1024) : m_arena(blockSize) {}
+		JsonDocument(const JsonDocument&) = delete;
+		JsonDocument& operator=(const JsonDocument&) = delete;
+		~JsonDocument() { clear(); }
+
+		// the previous document is released, references to its values become invalid.
+		const JsonObject& parse(std::string_view jsonString)
+		{
+			clear();
+			m_root = from::parse(jsonString, &m_arena);
+			return m_root;
+		}
+
+		// same as parse with from::parseIndexed, the structural index is kept for the next parse.
+		const JsonObject& parseIndexed(std::string_view jsonString)
+		{
+			clear();
+			if (jsonString.size() > std::numeric_limits<uint32_t>::max())
+			{
+				m_root = from::parse(jsonString, &m_arena);
+			}
+			else
+			{
+				m_root = from::_impl::parseIndexed(jsonString, &m_arena, m_index);
+			}
+			return m_root;
+		}
+
+		const JsonObject& getRoot() const { return m_root; }
+
+		void clear()
+		{
+			// the nodes live in the arena, they don't need to be walked to be freed.
+			m_root.abandon();
+			m_arena.reset();
+		}
+
+	private:
+		_impl::JsonArena m_arena;
+		JsonObject m_root;
+		std::vector<uint32_t> m_index;
+	};
+
+	// serializes many values one after the other into the same buffer,
+	// once the buffer has grown to the size of the largest output, writing doesn't allocate anymore.
+	class JsonWriter
+	{
+	public:
+		explicit JsonWriter(EJsonFormat format = EJsonFormat::Pretty) : m_format(format) {}
+
+		// the view is valid until the next call to the writer.
+		std::string_view write(const auto& data)
+		{
+			m_buffer.clear();
+			to::json(m_buffer, data, m_format);
+			return m_buffer;
+		}
+
+		// writes after what's already in the buffer, without any separator.
+		void append(const auto& data)
+		{
+			to::json(m_buffer, data, m_format);
+		}
+
+		void clear() { m_buffer.clear(); }
+		std::string_view getView() const { return m_buffer; }
+
+	private:
+		std::string m_buffer;
+		EJsonFormat m_format = EJsonFormat::Pretty;
+	};
+
+	// reads many documents of the same type in place: the record, its strings and containers and the parser's buffers
+	// are kept between documents, so reading stops allocating once they've grown to the size of the largest document.
+	template<typename T>
+	class JsonReader
+	{
+	public:
+		// the record ends up as if it was read into a new T, members missing from the document get their default value.
+		// an invalid document is reported and leaves a default record.
+		bool read(std::string_view jsonString, T& outRecord)
+		{
+			m_parser.begin = jsonString.data();
+			m_parser.it = jsonString.data();
+			m_parser.end = jsonString.data() + jsonString.size();
+			m_parser.isReusingRecords = true;
+			m_parser.hasError = false;
+
+			from::_impl::skipWhitespaces(m_parser);
+			if (m_parser.isAtEnd())
+			{
+				from::_impl::assignValue(outRecord, T());
+				return true;
+			}
+
+			if (from::_impl::readElement(m_parser, outRecord))
+			{
+				from::_impl::skipWhitespaces(m_parser);
+				if (m_parser.isAtEnd())
+				{
+					return true;
+				}
+			}
+
+			from::_impl::reportError(m_parser);
+			from::_impl::assignValue(outRecord, T());
+			return false;
+		}
+
+		bool read(std::string_view jsonString) { return read(jsonString, m_record); }
+
+		const T& get() const { return m_record; }
+
+	private:
+		from::_impl::JsonParser m_parser;
+		T m_record{};
+	};
+
+	namespace to
+	{
+		// one document per record, the strings of out are reused from the previous batch.
+		inline void jsonBatch(std::vector<std::string>& out, const auto& records, EJsonFormat format = EJsonFormat::Pretty)
+		{
+			out.resize(std::ranges::size(records));
+			size_t index = 0;
+			for (const auto& record : records)
+			{
+				out[index].clear();
+				json(out[index++], record, format);
+			}
+		}
+	}
+
+	namespace from
+	{
+		// one record per document, the records of outRecords are read in place.
+		// returns false if a document was invalid, its record is left to its default value.
 		template<class T>
-		inline T json(const std::string& jsonString)
+		inline bool jsonBatch(JsonReader<T>& reader, const auto& documents, std::vector<T>& outRecords)
 		{
-			T obj;
-			JsonObject json = parse(jsonString);
-			// we wrap the json object to kickstart the deserialization recursion
-			JsonObject wrapper;
-			wrapper["value"] = std::move(json);
-			_impl::deserializeMany(0, wrapper, { "value" }, obj);
-			return obj;
+			outRecords.resize(std::ranges::size(documents));
+			bool isValid = true;
+			size_t index = 0;
+			for (const auto& document : documents)
+			{
+				isValid = reader.read(std::string_view(document), outRecords[index++]) && isValid;
+			}
+			return isValid;
+		}
+
+		template<class T>
+		inline bool jsonBatch(const auto& documents, std::vector<T>& outRecords)
+		{
+			JsonReader<T> reader;
+			return jsonBatch(reader, documents, outRecords);
+		}
+	}
+
+	// reads json lines one record at a time, from a buffer or a stream.
+	// the record, its buffers and the line buffer are reused, so memory doesn't grow with the number of lines.
+	template<typename T>
+	class JsonLinesReader
+	{
+	public:
+		struct Iterator
+		{
+			using iterator_category = std::input_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+
+			JsonLinesReader* reader = nullptr;
+
+			const T& operator*() const { return reader->get(); }
+			const T* operator->() const { return &reader->get(); }
+			Iterator& operator++()
+			{
+				if (!reader->next())
+				{
+					reader = nullptr;
+				}
+				return *this;
+			}
+			void operator++(int) { ++*this; }
+			bool operator==(std::default_sentinel_t) const { return reader == nullptr; }
+		};
+
+		explicit JsonLinesReader(std::string_view data) : m_data(data) {}
+		explicit JsonLinesReader(std::istream& stream) : m_stream(&stream) {}
+
+		// reads the next record, invalid lines are reported and skipped. Returns false at the end of the input.
+		bool next()
+		{
+			std::string_view line;
+			while (readLine(line))
+			{
+				// members missing from a line don't keep the previous record's values, the reader resets them.
+				if (line.find_first_not_of(" \t\r\n") != std::string_view::npos && m_reader.read(line))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		const T& get() const { return m_reader.get(); }
+
+		Iterator begin()
+		{
+			Iterator it{ this };
+			return ++it;
+		}
+
+		std::default_sentinel_t end() const { return std::default_sentinel; }
+
+	private:
+		bool readLine(std::string_view& outLine)
+		{
+			if (m_stream != nullptr)
+			{
+				if (!std::getline(*m_stream, m_line))
+				{
+					return false;
+				}
+				outLine = m_line;
+				return true;
+			}
+
+			if (m_data.empty())
+			{
+				return false;
+			}
+
+			const size_t end = m_data.find('\n');
+			outLine = m_data.substr(0, end);
+			m_data.remove_prefix(end == std::string_view::npos ? m_data.size() : end + 1);
+			return true;
+		}
+
+		std::string_view m_data;
+		std::istream* m_stream = nullptr;
+		std::string m_line;
+		JsonReader<T> m_reader;
+	};
+
+	namespace from
+	{
+		template<class T>
+		inline JsonLinesReader<T> jsonLines(std::string_view data)
+		{
+			return JsonLinesReader<T>(data);
+		}
+
+		template<class T>
+		inline JsonLinesReader<T> jsonLines(std::istream& stream)
+		{
+			return JsonLinesReader<T>(stream);
 		}
 	}
-}
\ No newline at end of file
+
+	// push parser for documents that arrive in pieces, chunks can end anywhere, even in the middle of a token.
+	// the state lives in an explicit stack, so nothing but the unfinished token is buffered between calls.
+	// several documents can follow each other, each one is available as soon as its last character has been fed.
+	class JsonStreamParser
+	{
+	public:
+		explicit JsonStreamParser(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : m_resource(resource) {}
+
+		// returns false once the input isn't valid json, the parser then has to be reset.
+		bool feed(std::string_view chunk)
+		{
+			const char* it = chunk.data();
+			const char* end = chunk.data() + chunk.size();
+			while (it != end && !m_hasError)
+			{
+				m_position = m_offset + (it - chunk.data());
+				it = step(it, end);
+			}
+			m_offset += chunk.size();
+			return !m_hasError;
+		}
+
+		// a number can only be completed by the end of the input, documents left open are an error.
+		bool finish()
+		{
+			m_position = m_offset;
+			if (!m_hasError && m_state == EState::Primitive)
+			{
+				completePrimitive();
+			}
+
+			if (!m_hasError && (!m_frames.empty() || m_state != EState::Value))
+			{
+				error();
+			}
+			return !m_hasError;
+		}
+
+		// pops the next complete document.
+		bool next(JsonObject& outValue)
+		{
+			if (m_nextValue == m_values.size())
+			{
+				return false;
+			}
+
+			outValue = std::move(m_values[m_nextValue++]);
+			if (m_nextValue == m_values.size())
+			{
+				m_values.clear();
+				m_nextValue = 0;
+			}
+			return true;
+		}
+
+		// pops the next complete document into a T. The document is untrusted input,
+		// deserialize checks each value's type and skips the members that don't match.
+		template<typename T>
+		bool next(T& outValue) requires (!std::is_same_v<T, JsonObject>)
+		{
+			JsonObject json;
+			if (!next(json))
+			{
+				return false;
+			}
+			from::_impl::deserialize(json, outValue);
+			return true;
+		}
+
+		bool hasError() const { return m_hasError; }
+
+		void reset()
+		{
+			m_frames.clear();
+			m_values.clear();
+			m_nextValue = 0;
+			m_token.clear();
+			m_state = EState::Value;
+			m_offset = 0;
+			m_position = 0;
+			m_hasError = false;
+		}
+
+	private:
+		enum class EState : uint8_t
+		{
+			Value,
+			// an array element or the end of the array, after '[' and after a comma.
+			ValueOrEnd,
+			FirstKey,
+			Key,
+			Colon,
+			CommaOrEnd,
+			String,
+			Primitive,
+		};
+
+		struct Frame
+		{
+			bool isObject = false;
+			JsonObject object;
+			std::pmr::vector<JsonObject> array;
+			std::pmr::string key;
+		};
+
+		const char* step(const char* it, const char* end)
+		{
+			if (m_state == EState::String)
+			{
+				return readString(it, end);
+			}
+			else if (m_state == EState::Primitive)
+			{
+				return readPrimitive(it, end);
+			}
+
+			it = SIMD::skipWhitespaces(it, end);
+			if (it == end)
+			{
+				return it;
+			}
+
+			const char c = *it;
+			switch (m_state)
+			{
+			case EState::ValueOrEnd:
+				// like parse, a trailing comma is tolerated in arrays.
+				if (c == ']')
+				{
+					closeContainer();
+					return it + 1;
+				}
+				m_state = EState::Value;
+				return it;
+			case EState::Value:
+				if (c == '{' || c == '[')
+				{
+					// arrays only fill their vector, only objects need a node.
+					const bool isObject = c == '{';
+					m_frames.emplace_back(Frame{ isObject, isObject ? JsonObject(EJsonType::Object, m_resource) : JsonObject(), std::pmr::vector<JsonObject>(m_resource), std::pmr::string(m_resource) });
+					m_state = isObject ? EState::FirstKey : EState::ValueOrEnd;
+				}
+				else if (c == '"')
+				{
+					beginString(false);
+				}
+				else if (c == '}' || c == ']' || c == ',' || c == ':')
+				{
+					error();
+				}
+				else
+				{
+					m_token.clear();
+					m_state = EState::Primitive;
+					return it;
+				}
+				return it + 1;
+			case EState::FirstKey:
+			case EState::Key:
+				// like parse, a trailing comma is tolerated in objects.
+				if (c == '}')
+				{
+					closeContainer();
+				}
+				else if (c == '"')
+				{
+					beginString(true);
+				}
+				else
+				{
+					error();
+				}
+				return it + 1;
+			case EState::Colon:
+				if (c != ':')
+				{
+					error();
+				}
+				m_state = EState::Value;
+				return it + 1;
+			case EState::CommaOrEnd:
+				if (c == ',')
+				{
+					m_state = m_frames.back().isObject ? EState::Key : EState::ValueOrEnd;
+				}
+				else if (c == (m_frames.back().isObject ? '}' : ']'))
+				{
+					closeContainer();
+				}
+				else
+				{
+					error();
+				}
+				return it + 1;
+			default:
+				return it;
+			}
+		}
+
+		void beginString(bool isKey)
+		{
+			m_token.clear();
+			m_isKey = isKey;
+			m_isEscaped = false;
+			m_hasEscapes = false;
+			m_state = EState::String;
+		}
+
+		const char* readString(const char* it, const char* end)
+		{
+			while (it != end)
+			{
+				if (m_isEscaped)
+				{
+					m_token.push_back(*it++);
+					m_isEscaped = false;
+					continue;
+				}
+
+				const char* special = SIMD::findQuoteOrBackslash(it, end);
+				m_token.append(it, special);
+				if (special == end)
+				{
+					return end;
+				}
+
+				if (*special == '\\')
+				{
+					m_token.push_back('\\');
+					m_isEscaped = true;
+					m_hasEscapes = true;
+					it = special + 1;
+					continue;
+				}
+
+				// closing quote
+				std::pmr::string value(m_resource);
+				if (m_hasEscapes)
+				{
+					from::_impl::unescape(value, m_token);
+				}
+				else
+				{
+					value.assign(m_token);
+				}
+
+				if (m_isKey)
+				{
+					m_frames.back().key = std::move(value);
+					m_state = EState::Colon;
+				}
+				else
+				{
+					completeValue(JsonObject(std::move(value)));
+				}
+				return special + 1;
+			}
+			return it;
+		}
+
+		const char* readPrimitive(const char* it, const char* end)
+		{
+			const char* start = it;
+			while (it != end && *it != ',' && *it != '}' && *it != ']' && !SIMD::_impl::isWhitespace(*it))
+			{
+				it++;
+			}
+			m_token.append(start, it);
+
+			// the delimiter is handled by the next step.
+			if (it != end)
+			{
+				completePrimitive();
+			}
+			return it;
+		}
+
+		void completePrimitive()
+		{
+			JsonObject value;
+			if (!from::_impl::parsePrimitive(m_token, value))
+			{
+				error();
+				return;
+			}
+			completeValue(std::move(value));
+		}
+
+		void closeContainer()
+		{
+			Frame frame = std::move(m_frames.back());
+			m_frames.pop_back();
+			completeValue(frame.isObject ? std::move(frame.object) : JsonObject(std::move(frame.array)));
+		}
+
+		void completeValue(JsonObject&& value)
+		{
+			if (m_frames.empty())
+			{
+				m_values.push_back(std::move(value));
+				m_state = EState::Value;
+				return;
+			}
+
+			Frame& frame = m_frames.back();
+			if (frame.isObject)
+			{
+				frame.object.emplace(std::move(frame.key), std::move(value));
+				frame.key = std::pmr::string(m_resource);
+			}
+			else
+			{
+				frame.array.push_back(std::move(value));
+			}
+			m_state = EState::CommaOrEnd;
+		}
+
+		void error()
+		{
+			if (!m_hasError)
+			{
+				m_hasError = true;
+				std::cout << std::format("[ManiZ::json]: failed to parse, error at byte {}", m_position) << std::endl;
+			}
+		}
+
+		std::pmr::memory_resource* m_resource = nullptr;
+		std::vector<Frame> m_frames;
+		std::vector<JsonObject> m_values;
+		size_t m_nextValue = 0;
+		// the unfinished string or primitive, the only input kept between two chunks.
+		std::string m_token;
+		EState m_state = EState::Value;
+		// bytes fed so far, and where the current step started, for error reporting.
+		size_t m_offset = 0;
+		size_t m_position = 0;
+		bool m_isKey = false;
+		bool m_isEscaped = false;
+		bool m_hasEscapes = false;
+		bool m_hasError = false;
+	};
+}
@@ -1,5 +1,8 @@
 #pragma once
 
 #include "Reflection.h"
+#include "Simd.h"
+#include "Sink.h"
 #include "Json.h"
 #include "Binary.h"
+#include "File.h"
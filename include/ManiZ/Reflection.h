@@ -2,6 +2,8 @@
 
 #include <vector>
 #include <array>
+#include <string_view>
+#include <utility>
 #include <variant>
 #include <source_location>
 #include <iostream>
@@ -501,28 +503,21 @@ namespace ManiZ
 				return raw.substr(begin, end - begin);
 			}
 
-			template<typename T, size_t I, size_t N>
-			inline constexpr void getMemberNames_impl(std::array<std::string, N>& acc)
+			template<typename T, size_t ...I>
+			inline constexpr auto makeMemberNameTable(std::index_sequence<I...>)
 			{
-				static_assert(I < N, "I(index) out of bounds");
-				acc[I] = getMemberName<T, I>();
-				if constexpr (I == 0)
-				{
-					return;
-				}
-				else
-				{
-					getMemberNames_impl<T, I - 1, N>(acc);
-				}
+				return std::array<std::string_view, sizeof...(I)>{ getMemberName<T, I>()... };
 			}
 
+			// built once per type at compile time, indexed by the member's position in the aggregate.
+			template<typename T>
+			inline constexpr std::array<std::string_view, memberCount<T>()> memberNameTable = makeMemberNameTable<T>(std::make_index_sequence<memberCount<T>()>{});
+
 			template<typename T>
 			inline constexpr auto getMemberNames()
 			{
-				constexpr size_t count = memberCount<T>();
-				std::array<std::string, count> acc;
-				getMemberNames_impl<T, count - 1, count>(acc);
-				std::vector<std::string> v(std::begin(acc), std::end(acc));
+				constexpr auto& table = memberNameTable<T>;
+				std::vector<std::string> v(std::begin(table), std::end(table));
 				return v;
 			}
 
@@ -582,6 +577,12 @@ namespace ManiZ
 			return _impl::getMemberNames<T>();
 		}
 
+		template<typename T>
+		inline constexpr const auto& getMemberNameTable()
+		{
+			return _impl::memberNameTable<T>;
+		}
+
 		template<typename T>
 		inline constexpr auto getTypeName(bool withNamespace = false)
 		{
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#define MANIZ_SIMD_X86 1
+	#include <immintrin.h>
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#endif
+#else
+	#define MANIZ_SIMD_X86 0
+#endif
+
+// msvc lets any function use avx2 intrinsics, gcc and clang need the target to be enabled per function.
+#if MANIZ_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+	#define MANIZ_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+	#define MANIZ_SIMD_TARGET_AVX2
+#endif
+
+namespace ManiZ
+{
+	namespace SIMD
+	{
+		enum class EInstructionSet : uint8_t
+		{
+			Scalar,
+			SSE2,
+			AVX2,
+		};
+
+		// one bit per character of a 64 bytes block, the first character is the lowest bit.
+		struct BlockMasks
+		{
+			uint64_t quote = 0;
+			uint64_t backslash = 0;
+			uint64_t whitespace = 0;
+			// {}[]:,
+			uint64_t structural = 0;
+		};
+
+		// scans return the first matching character in [it, end), or end.
+		using ScanFunction = const char* (*)(const char* it, const char* end);
+		// classifies exactly 64 bytes.
+		using ClassifyFunction = void (*)(const char* block, BlockMasks& outMasks);
+
+		struct Kernels
+		{
+			EInstructionSet instructionSet = EInstructionSet::Scalar;
+			ScanFunction skipWhitespaces = nullptr;
+			ScanFunction findQuoteOrBackslash = nullptr;
+			ClassifyFunction classifyBlock = nullptr;
+		};
+
+		namespace _impl
+		{
+			inline bool isWhitespace(char c)
+			{
+				return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+			}
+
+			inline const char* skipWhitespacesScalar(const char* it, const char* end)
+			{
+				while (it != end && isWhitespace(*it))
+				{
+					it++;
+				}
+				return it;
+			}
+
+			inline const char* findQuoteOrBackslashScalar(const char* it, const char* end)
+			{
+				while (it != end && *it != '"' && *it != '\\')
+				{
+					it++;
+				}
+				return it;
+			}
+
+			inline void classifyBlockScalar(const char* block, BlockMasks& outMasks)
+			{
+				outMasks = BlockMasks();
+				for (uint32_t i = 0; i < 64; i++)
+				{
+					const char c = block[i];
+					const uint64_t bit = 1ull << i;
+					outMasks.quote |= c == '"' ? bit : 0;
+					outMasks.backslash |= c == '\\' ? bit : 0;
+					outMasks.whitespace |= isWhitespace(c) ? bit : 0;
+					outMasks.structural |= (c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',') ? bit : 0;
+				}
+			}
+
+#if MANIZ_SIMD_X86
+			inline const char* skipWhitespacesSSE2(const char* it, const char* end)
+			{
+				const __m128i space = _mm_set1_epi8(' ');
+				const __m128i newLine = _mm_set1_epi8('\n');
+				const __m128i tab = _mm_set1_epi8('\t');
+				const __m128i carriageReturn = _mm_set1_epi8('\r');
+				while (end - it >= 16)
+				{
+					const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+					const __m128i isWhitespace = _mm_or_si128(
+						_mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, newLine)),
+						_mm_or_si128(_mm_cmpeq_epi8(chunk, tab), _mm_cmpeq_epi8(chunk, carriageReturn)));
+					const uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(isWhitespace)) & 0xFFFF;
+					if (mask != 0)
+					{
+						return it + std::countr_zero(mask);
+					}
+					it += 16;
+				}
+				return skipWhitespacesScalar(it, end);
+			}
+
+			inline const char* findQuoteOrBackslashSSE2(const char* it, const char* end)
+			{
+				const __m128i quote = _mm_set1_epi8('"');
+				const __m128i backslash = _mm_set1_epi8('\\');
+				while (end - it >= 16)
+				{
+					const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+					const __m128i isMatch = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+					const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(isMatch));
+					if (mask != 0)
+					{
+						return it + std::countr_zero(mask);
+					}
+					it += 16;
+				}
+				return findQuoteOrBackslashScalar(it, end);
+			}
+
+			inline void classifyBlockSSE2(const char* block, BlockMasks& outMasks)
+			{
+				outMasks = BlockMasks();
+				for (uint32_t offset = 0; offset < 64; offset += 16)
+				{
+					const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + offset));
+					const auto match = [&](char c) { return _mm_cmpeq_epi8(chunk, _mm_set1_epi8(c)); };
+					const auto toMask = [&](__m128i bytes) { return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(bytes))) << offset; };
+
+					outMasks.quote |= toMask(match('"'));
+					outMasks.backslash |= toMask(match('\\'));
+					outMasks.whitespace |= toMask(_mm_or_si128(_mm_or_si128(match(' '), match('\n')), _mm_or_si128(match('\t'), match('\r'))));
+					outMasks.structural |= toMask(_mm_or_si128(
+						_mm_or_si128(_mm_or_si128(match('{'), match('}')), _mm_or_si128(match('['), match(']'))),
+						_mm_or_si128(match(':'), match(','))));
+				}
+			}
+
+			MANIZ_SIMD_TARGET_AVX2 inline const char* skipWhitespacesAVX2(const char* it, const char* end)
+			{
+				const __m256i space = _mm256_set1_epi8(' ');
+				const __m256i newLine = _mm256_set1_epi8('\n');
+				const __m256i tab = _mm256_set1_epi8('\t');
+				const __m256i carriageReturn = _mm256_set1_epi8('\r');
+				while (end - it >= 32)
+				{
+					const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it));
+					const __m256i isWhitespace = _mm256_or_si256(
+						_mm256_or_si256(_mm256_cmpeq_epi8(chunk, space), _mm256_cmpeq_epi8(chunk, newLine)),
+						_mm256_or_si256(_mm256_cmpeq_epi8(chunk, tab), _mm256_cmpeq_epi8(chunk, carriageReturn)));
+					const uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(isWhitespace));
+					if (mask != 0)
+					{
+						return it + std::countr_zero(mask);
+					}
+					it += 32;
+				}
+				return skipWhitespacesSSE2(it, end);
+			}
+
+			MANIZ_SIMD_TARGET_AVX2 inline const char* findQuoteOrBackslashAVX2(const char* it, const char* end)
+			{
+				const __m256i quote = _mm256_set1_epi8('"');
+				const __m256i backslash = _mm256_set1_epi8('\\');
+				while (end - it >= 32)
+				{
+					const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it));
+					const __m256i isMatch = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash));
+					const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(isMatch));
+					if (mask != 0)
+					{
+						return it + std::countr_zero(mask);
+					}
+					it += 32;
+				}
+				return findQuoteOrBackslashSSE2(it, end);
+			}
+
+			MANIZ_SIMD_TARGET_AVX2 inline void classifyBlockAVX2(const char* block, BlockMasks& outMasks)
+			{
+				outMasks = BlockMasks();
+				for (uint32_t offset = 0; offset < 64; offset += 32)
+				{
+					const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + offset));
+					const auto match = [&](char c) MANIZ_SIMD_TARGET_AVX2 { return _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(c)); };
+					const auto toMask = [&](__m256i bytes) MANIZ_SIMD_TARGET_AVX2 { return static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(bytes))) << offset; };
+
+					outMasks.quote |= toMask(match('"'));
+					outMasks.backslash |= toMask(match('\\'));
+					outMasks.whitespace |= toMask(_mm256_or_si256(_mm256_or_si256(match(' '), match('\n')), _mm256_or_si256(match('\t'), match('\r'))));
+					outMasks.structural |= toMask(_mm256_or_si256(
+						_mm256_or_si256(_mm256_or_si256(match('{'), match('}')), _mm256_or_si256(match('['), match(']'))),
+						_mm256_or_si256(match(':'), match(','))));
+				}
+			}
+
+			inline bool isAVX2Supported()
+			{
+#if defined(_MSC_VER)
+				int info[4] = {};
+				__cpuid(info, 0);
+				if (info[0] < 7)
+				{
+					return false;
+				}
+
+				// the os also has to save the ymm registers on context switches.
+				__cpuid(info, 1);
+				const bool hasOSXSave = (info[2] & (1 << 27)) != 0;
+				if (!hasOSXSave || (_xgetbv(0) & 0x6) != 0x6)
+				{
+					return false;
+				}
+
+				__cpuidex(info, 7, 0);
+				return (info[1] & (1 << 5)) != 0;
+#else
+				__builtin_cpu_init();
+				return __builtin_cpu_supports("avx2");
+#endif
+			}
+#endif
+
+			inline Kernels selectKernels()
+			{
+#if MANIZ_SIMD_X86
+				if (isAVX2Supported())
+				{
+					return { EInstructionSet::AVX2, &skipWhitespacesAVX2, &findQuoteOrBackslashAVX2, &classifyBlockAVX2 };
+				}
+				// sse2 is part of every x86-64 cpu.
+				return { EInstructionSet::SSE2, &skipWhitespacesSSE2, &findQuoteOrBackslashSSE2, &classifyBlockSSE2 };
+#else
+				return { EInstructionSet::Scalar, &skipWhitespacesScalar, &findQuoteOrBackslashScalar, &classifyBlockScalar };
+#endif
+			}
+		}
+
+		// the kernels are selected once, from the features of the cpu the program runs on.
+		inline const Kernels& getKernels()
+		{
+			static const Kernels kernels = _impl::selectKernels();
+			return kernels;
+		}
+
+		inline const char* skipWhitespaces(const char* it, const char* end)
+		{
+			return getKernels().skipWhitespaces(it, end);
+		}
+
+		inline const char* findQuoteOrBackslash(const char* it, const char* end)
+		{
+			return getKernels().findQuoteOrBackslash(it, end);
+		}
+
+		inline void classifyBlock(const char* block, BlockMasks& outMasks)
+		{
+			getKernels().classifyBlock(block, outMasks);
+		}
+
+		// each output bit is the xor of all the input bits up to and including it.
+		inline uint64_t prefixXor(uint64_t bits)
+		{
+			bits ^= bits << 1;
+			bits ^= bits << 2;
+			bits ^= bits << 4;
+			bits ^= bits << 8;
+			bits ^= bits << 16;
+			bits ^= bits << 32;
+			return bits;
+		}
+	}
+}
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <string_view>
+#include <string>
+#include <span>
+#include <vector>
+#include <functional>
+#include <ostream>
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+#include <format>
+
+#if defined(_WIN32)
+	#include <io.h>
+#else
+	#include <unistd.h>
+	#include <sys/uio.h>
+	#include <climits>
+	#include <cerrno>
+#endif
+
+namespace ManiZ
+{
+	// fixed size output buffer, handed to a flush function whenever it's full.
+	// serializers only need push_back and append, so the memory used doesn't depend on the size of the output.
+	class BufferedSink
+	{
+	public:
+		// returns false when the data couldn't be written, nothing is written after a failure.
+		using FlushFunction = std::function<bool(std::string_view data)>;
+
+		static constexpr size_t DefaultBufferSize = 64 * 1024;
+
+		explicit BufferedSink(FlushFunction flush, size_t bufferSize = DefaultBufferSize)
+			: m_buffer(std::max<size_t>(bufferSize, 1))
+			, m_flush(std::move(flush))
+		{
+		}
+
+		explicit BufferedSink(std::ostream& stream, size_t bufferSize = DefaultBufferSize)
+			: BufferedSink([&stream](std::string_view data) { return static_cast<bool>(stream.write(data.data(), data.size())); }, bufferSize)
+		{
+		}
+
+		// the file descriptor stays open, it belongs to the caller.
+		explicit BufferedSink(int fileDescriptor, size_t bufferSize = DefaultBufferSize)
+			: BufferedSink([fileDescriptor](std::string_view data) { return writeToFile(fileDescriptor, data); }, bufferSize)
+		{
+			m_fileDescriptor = fileDescriptor;
+		}
+
+		BufferedSink(const BufferedSink&) = delete;
+		BufferedSink& operator=(const BufferedSink&) = delete;
+
+		~BufferedSink() { flush(); }
+
+		void push_back(char c)
+		{
+			if (m_size == m_buffer.size())
+			{
+				flush();
+			}
+			m_buffer[m_size++] = c;
+		}
+
+		void append(std::string_view data)
+		{
+			if (data.size() > m_buffer.size() - m_size)
+			{
+				flush();
+
+				// too large to be buffered, it goes straight through.
+				if (data.size() >= m_buffer.size())
+				{
+					write(data);
+					return;
+				}
+			}
+
+			std::memcpy(m_buffer.data() + m_size, data.data(), data.size());
+			m_size += data.size();
+		}
+
+		// buffers that are already built are written as they are, with a single vectored write for file descriptors.
+		void appendChunks(std::span<const std::string> chunks)
+		{
+			flush();
+			if (m_hasError)
+			{
+				return;
+			}
+
+#if !defined(_WIN32)
+			if (m_fileDescriptor >= 0)
+			{
+				size_t size = 0;
+				for (const std::string& chunk : chunks)
+				{
+					size += chunk.size();
+				}
+
+				if (!writeToFile(m_fileDescriptor, chunks))
+				{
+					m_hasError = true;
+					std::cout << std::format("[ManiZ::sink]: failed to write {} bytes after {} bytes", size, m_writtenSize) << std::endl;
+					return;
+				}
+				m_writtenSize += size;
+				return;
+			}
+#endif
+			for (const std::string& chunk : chunks)
+			{
+				write(chunk);
+			}
+		}
+
+		bool flush()
+		{
+			if (m_size > 0)
+			{
+				write(std::string_view(m_buffer.data(), m_size));
+				m_size = 0;
+			}
+			return !m_hasError;
+		}
+
+		bool hasError() const { return m_hasError; }
+		size_t getWrittenSize() const { return m_writtenSize; }
+
+	private:
+		void write(std::string_view data)
+		{
+			if (m_hasError)
+			{
+				return;
+			}
+
+			if (!m_flush(data))
+			{
+				m_hasError = true;
+				std::cout << std::format("[ManiZ::sink]: failed to write {} bytes after {} bytes", data.size(), m_writtenSize) << std::endl;
+				return;
+			}
+			m_writtenSize += data.size();
+		}
+
+		static bool writeToFile(int fileDescriptor, std::string_view data)
+		{
+			// writes can be partial or interrupted, they're retried until everything is written.
+			while (!data.empty())
+			{
+#if defined(_WIN32)
+				const int written = _write(fileDescriptor, data.data(), static_cast<unsigned int>(std::min<size_t>(data.size(), 1u << 30)));
+#else
+				const ssize_t written = ::write(fileDescriptor, data.data(), data.size());
+				if (written < 0 && errno == EINTR)
+				{
+					continue;
+				}
+#endif
+				if (written <= 0)
+				{
+					return false;
+				}
+				data.remove_prefix(static_cast<size_t>(written));
+			}
+			return true;
+		}
+
+#if !defined(_WIN32)
+		static bool writeToFile(int fileDescriptor, std::span<const std::string> chunks)
+		{
+			std::vector<iovec> vectors;
+			vectors.reserve(chunks.size());
+			for (const std::string& chunk : chunks)
+			{
+				if (!chunk.empty())
+				{
+					vectors.push_back({ const_cast<char*>(chunk.data()), chunk.size() });
+				}
+			}
+
+			size_t index = 0;
+			while (index < vectors.size())
+			{
+				const int count = static_cast<int>(std::min<size_t>(vectors.size() - index, IOV_MAX));
+				const ssize_t written = ::writev(fileDescriptor, vectors.data() + index, count);
+				if (written < 0 && errno == EINTR)
+				{
+					continue;
+				}
+				if (written <= 0)
+				{
+					return false;
+				}
+
+				// skips what has been written, the last buffer can be partially written.
+				size_t remaining = static_cast<size_t>(written);
+				while (index < vectors.size() && remaining >= vectors[index].iov_len)
+				{
+					remaining -= vectors[index].iov_len;
+					index++;
+				}
+
+				if (remaining > 0)
+				{
+					vectors[index].iov_base = static_cast<char*>(vectors[index].iov_base) + remaining;
+					vectors[index].iov_len -= remaining;
+				}
+			}
+			return true;
+		}
+#endif
+
+		std::vector<char> m_buffer;
+		size_t m_size = 0;
+		size_t m_writtenSize = 0;
+		FlushFunction m_flush;
+		int m_fileDescriptor = -1;
+		bool m_hasError = false;
+	};
+}